@@ -35,6 +35,35 @@ class EOS {
   // !IsConstantMolarMass()
   virtual bool IsConstantMolarMass() = 0;
   virtual double MolarMass() = 0;
+
+  // Batched methods, evaluated at n points of temperature T and pressure p.
+  // Any of the outputs may be null, in which case it is not computed, so
+  // that density and its derivatives can be evaluated in a single pass.  The
+  // defaults simply call the pointwise methods, and should be overridden
+  // with tight loops by EOSs that are evaluated on many cells.
+  virtual void MassDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) {
+    std::vector<double> params(2);
+    for (int i=0; i!=n; ++i) {
+      params[0] = T[i];
+      params[1] = p[i];
+      if (dens) dens[i] = MassDensity(params);
+      if (d_dens_dT) d_dens_dT[i] = DMassDensityDT(params);
+      if (d_dens_dp) d_dens_dp[i] = DMassDensityDp(params);
+    }
+  }
+
+  virtual void MolarDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) {
+    std::vector<double> params(2);
+    for (int i=0; i!=n; ++i) {
+      params[0] = T[i];
+      params[1] = p[i];
+      if (dens) dens[i] = MolarDensity(params);
+      if (d_dens_dT) d_dens_dT[i] = DMolarDensityDT(params);
+      if (d_dens_dp) d_dens_dp[i] = DMolarDensityDp(params);
+    }
+  }
 };
 
 } // namespace
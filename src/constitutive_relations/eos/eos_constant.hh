@@ -14,6 +14,8 @@
 #ifndef AMANZI_RELATIONS_EOS_CONSTANT_HH_
 #define AMANZI_RELATIONS_EOS_CONSTANT_HH_
 
+#include <algorithm>
+
 #include "Teuchos_ParameterList.hpp"
 
 #include "Factory.hh"
@@ -35,9 +37,25 @@ public:
   virtual double DMolarDensityDT(std::vector<double>& params) override { return 0.0; }
   virtual double DMolarDensityDp(std::vector<double>& params) override { return 0.0; }
 
+  virtual void MassDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) override {
+    FillBatch_(n, rho_, dens, d_dens_dT, d_dens_dp);
+  }
+  virtual void MolarDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) override {
+    FillBatch_(n, rho_ / M_, dens, d_dens_dT, d_dens_dp);
+  }
+
 private:
   virtual void InitializeFromPlist_();
 
+  static void FillBatch_(int n, double val,
+                         double* dens, double* d_dens_dT, double* d_dens_dp) {
+    if (dens) std::fill(dens, dens+n, val);
+    if (d_dens_dT) std::fill(d_dens_dT, d_dens_dT+n, 0.);
+    if (d_dens_dp) std::fill(d_dens_dp, d_dens_dp+n, 0.);
+  }
+
   Teuchos::ParameterList eos_plist_;
   double rho_;
 
@@ -59,6 +59,14 @@ class EOSConstantMolarMass : public EOS {
   virtual double MolarMass() { return M_; }
 
  protected:
+  // scales batched outputs, e.g. to convert mass to molar densities
+  static void ScaleBatch_(int n, double scale,
+                          double* dens, double* d_dens_dT, double* d_dens_dp) {
+    if (dens) for (int i=0; i!=n; ++i) dens[i] *= scale;
+    if (d_dens_dT) for (int i=0; i!=n; ++i) d_dens_dT[i] *= scale;
+    if (d_dens_dp) for (int i=0; i!=n; ++i) d_dens_dp[i] *= scale;
+  }
+
   double M_;
 
 };
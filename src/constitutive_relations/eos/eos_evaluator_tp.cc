@@ -60,15 +60,10 @@ Teuchos::RCP<FieldEvaluator> EOSEvaluatorTP::Clone() const {
 
 void EOSEvaluatorTP::EvaluateField_(const Teuchos::Ptr<State>& S,
                          const std::vector<Teuchos::Ptr<CompositeVector> >& results) {
-  
-  int num_dep = dependencies_.size();  
-  std::vector<double> eos_params(num_dep);
-
+  // Pull dependencies out of state.
   Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
   Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
 
-  // Pull dependencies out of state.  
-
   Teuchos::Ptr<CompositeVector> molar_dens, mass_dens;
   if (mode_ == EOS_MODE_MOLAR) {
     molar_dens = results[0];
@@ -79,25 +74,18 @@ void EOSEvaluatorTP::EvaluateField_(const Teuchos::Ptr<State>& S,
     mass_dens = results[1];
   }
 
-
   if (molar_dens != Teuchos::null) {
     // evaluate MolarDensity()
     for (CompositeVector::name_iterator comp=molar_dens->begin();
          comp!=molar_dens->end(); ++comp) {
-
-
       const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
       const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
       Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
 
       int count = dens_v.MyLength();
+      eos_->MolarDensityBatch(count, temp_v[0], pres_v[0], dens_v[0], nullptr, nullptr);
+
       for (int id=0; id!=count; ++id) {
-        
-        eos_params[0] = temp_v[0][id];
-        eos_params[1] = pres_v[0][id];
-       
-        dens_v[0][id] = eos_->MolarDensity(eos_params);
-                  
         if (dens_v[0][id] < 0.){
           Errors::Message msg;
           msg<<"Values of pressure and temperature result in negative density\n"<<
@@ -106,7 +94,6 @@ void EOSEvaluatorTP::EvaluateField_(const Teuchos::Ptr<State>& S,
             "Density "<< dens_v[0][id]<<"\n";
           Exceptions::amanzi_throw(msg);
         }
-        
       }
     }
   }
@@ -123,36 +110,28 @@ void EOSEvaluatorTP::EvaluateField_(const Teuchos::Ptr<State>& S,
                 *molar_dens->ViewComponent(*comp,false), 0.);
       } else {
         // evaluate MassDensity() directly
-
         const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
         const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
         Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
 
         int count = dens_v.MyLength();
-        for (int id=0; id!=count; ++id) {
-          
-          eos_params[0] = temp_v[0][id];
-          eos_params[1] = pres_v[0][id];          
-          dens_v[0][id] = eos_->MassDensity(eos_params);
-          AMANZI_ASSERT(dens_v[0][id] > 0.);
-        }
+        eos_->MassDensityBatch(count, temp_v[0], pres_v[0], dens_v[0], nullptr, nullptr);
+        for (int id=0; id!=count; ++id) AMANZI_ASSERT(dens_v[0][id] > 0.);
       }
     }
   }
 }
 
-  
+
 void EOSEvaluatorTP::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
                                                    Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> >& results) {
-  
-  int num_dep = dependencies_.size();  
-  std::vector<double> eos_params(num_dep);
-   
-  // Pull dependencies out of state.  
+  AMANZI_ASSERT(wrt_key == pres_key_ || wrt_key == temp_key_);
+  bool wrt_pres = wrt_key == pres_key_;
+
+  // Pull dependencies out of state.
   Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
-  Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);  
+  Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
 
-  
   Teuchos::Ptr<CompositeVector> molar_dens, mass_dens;
   if (mode_ == EOS_MODE_MOLAR) {
     molar_dens = results[0];
@@ -163,100 +142,43 @@ void EOSEvaluatorTP::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>&
     mass_dens = results[1];
   }
 
-  if (wrt_key == pres_key_) {
-    if (molar_dens != Teuchos::null) {
-      // evaluate MolarDensity()
-      for (CompositeVector::name_iterator comp=molar_dens->begin();
-           comp!=molar_dens->end(); ++comp) {
-        const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-        const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-        Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
-
-        int count = dens_v.MyLength();
-        for (int i=0; i!=count; ++i) {
-          eos_params[0] = temp_v[0][i];
-          eos_params[1] = pres_v[0][i];
-            
-          dens_v[0][i] = eos_->DMolarDensityDp(eos_params);
-        }
-      }
-    }
+  if (molar_dens != Teuchos::null) {
+    // evaluate DMolarDensityDp() or DMolarDensityDT()
+    for (CompositeVector::name_iterator comp=molar_dens->begin();
+         comp!=molar_dens->end(); ++comp) {
+      const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
+      const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
+      Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
 
-    if (mass_dens != Teuchos::null) {
-      for (CompositeVector::name_iterator comp=mass_dens->begin();
-           comp!=mass_dens->end(); ++comp) {
-        if (mode_ == EOS_MODE_BOTH && eos_->IsConstantMolarMass() &&
-            molar_dens->HasComponent(*comp)) {
-          // calculate MassDensity from MolarDensity and molar mass.
-          double M = eos_->MolarMass();
-
-          mass_dens->ViewComponent(*comp,false)->Update(M,
-                  *molar_dens->ViewComponent(*comp,false), 0.);
-        } else {
-          // evaluate MassDensity() directly
-          const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-          const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-          Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
-
-          int count = dens_v.MyLength();
-          for (int i=0; i!=count; ++i) {
-            eos_params[0] = temp_v[0][i];
-            eos_params[1] = pres_v[0][i];            
-            dens_v[0][i] = eos_->DMassDensityDp(eos_params);
-          }
-        }
-      }
+      int count = dens_v.MyLength();
+      eos_->MolarDensityBatch(count, temp_v[0], pres_v[0], nullptr,
+              wrt_pres ? nullptr : dens_v[0], wrt_pres ? dens_v[0] : nullptr);
     }
+  }
 
-  } else if (wrt_key == temp_key_) {
+  if (mass_dens != Teuchos::null) {
+    for (CompositeVector::name_iterator comp=mass_dens->begin();
+         comp!=mass_dens->end(); ++comp) {
+      if (mode_ == EOS_MODE_BOTH && eos_->IsConstantMolarMass() &&
+          molar_dens->HasComponent(*comp)) {
+        // calculate MassDensity from MolarDensity and molar mass.
+        double M = eos_->MolarMass();
 
-    if (molar_dens != Teuchos::null) {
-      // evaluate MolarDensity()
-      for (CompositeVector::name_iterator comp=molar_dens->begin();
-           comp!=molar_dens->end(); ++comp) {
+        mass_dens->ViewComponent(*comp,false)->Update(M,
+                *molar_dens->ViewComponent(*comp,false), 0.);
+      } else {
+        // evaluate DMassDensityDp() or DMassDensityDT() directly
         const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
         const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-        Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
+        Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
 
         int count = dens_v.MyLength();
-        for (int i=0; i!=count; ++i) {
-          eos_params[0] = temp_v[0][i];
-          eos_params[1] = pres_v[0][i];          
-          dens_v[0][i] = eos_->DMolarDensityDT(eos_params);
-        }
-      }
-    }
-
-    if (mass_dens != Teuchos::null) {
-      for (CompositeVector::name_iterator comp=mass_dens->begin();
-           comp!=mass_dens->end(); ++comp) {
-        if (mode_ == EOS_MODE_BOTH && eos_->IsConstantMolarMass() &&
-            molar_dens->HasComponent(*comp)) {
-          // calculate MassDensity from MolarDensity and molar mass.
-          double M = eos_->MolarMass();
-
-          mass_dens->ViewComponent(*comp,false)->Update(M,
-                  *molar_dens->ViewComponent(*comp,false), 0.);
-        } else {
-          // evaluate MassDensity() directly
-          const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-          const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-          Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
-
-          int count = dens_v.MyLength();
-          for (int i=0; i!=count; ++i) {
-            eos_params[0] = temp_v[0][i];
-            eos_params[1] = pres_v[0][i];            
-            dens_v[0][i] = eos_->DMassDensityDT(eos_params);
-          }
-        }
+        eos_->MassDensityBatch(count, temp_v[0], pres_v[0], nullptr,
+                wrt_pres ? nullptr : dens_v[0], wrt_pres ? dens_v[0] : nullptr);
       }
     }
-
-  } else {
-    AMANZI_ASSERT(0);
   }
-  } 
+}
 
 } // namespace
 } // namespace
@@ -75,6 +75,39 @@ double EOSIce::DMassDensityDp(std::vector<double>& params) {
 };
 
 
+void EOSIce::MassDensityBatch(int n, const double* T, const double* p,
+        double* dens, double* d_dens_dT, double* d_dens_dp) {
+  if (dens) {
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = ka_ + (kb_ + kc_*dT)*dT;
+      dens[i] = rho1bar * (1.0 + kalpha_*(std::max(p[i], 101325.) - kp0_));
+    }
+  }
+  if (d_dens_dT) {
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = kb_ + 2.0*kc_*dT;
+      d_dens_dT[i] = rho1bar * (1.0 + kalpha_*(std::max(p[i], 101325.) - kp0_));
+    }
+  }
+  if (d_dens_dp) {
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = ka_ + (kb_ + kc_*dT)*dT;
+      d_dens_dp[i] = p[i] < 101325. ? 0. : rho1bar * kalpha_;
+    }
+  }
+}
+
+
+void EOSIce::MolarDensityBatch(int n, const double* T, const double* p,
+        double* dens, double* d_dens_dT, double* d_dens_dp) {
+  MassDensityBatch(n, T, p, dens, d_dens_dT, d_dens_dp);
+  ScaleBatch_(n, 1.0/M_, dens, d_dens_dT, d_dens_dp);
+}
+
+
 void EOSIce::InitializeFromPlist_() {
   if (eos_plist_.isParameter("Molar mass of ice [kg/mol]")) {
     M_ = eos_plist_.get<double>("Molar mass of ice [kg/mol]");
@@ -32,6 +32,11 @@ public:
   virtual double DMassDensityDT(std::vector<double>& params) override;
   virtual double DMassDensityDp(std::vector<double>& params) override;
 
+  virtual void MassDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) override;
+  virtual void MolarDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) override;
+
 private:
   virtual void InitializeFromPlist_();
 
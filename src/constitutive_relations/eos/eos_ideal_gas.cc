@@ -37,6 +37,26 @@ double EOSIdealGas::DMolarDensityDp(std::vector<double>& params) {
 };
 
 
+void EOSIdealGas::MolarDensityBatch(int n, const double* T, const double* p,
+        double* dens, double* d_dens_dT, double* d_dens_dp) {
+  if (dens) {
+    for (int i=0; i!=n; ++i) dens[i] = std::max(p[i], 101325.) / (R_*T[i]);
+  }
+  if (d_dens_dT) {
+    for (int i=0; i!=n; ++i) d_dens_dT[i] = -std::max(p[i], 101325.) / (R_*T[i]*T[i]);
+  }
+  if (d_dens_dp) {
+    for (int i=0; i!=n; ++i) d_dens_dp[i] = 1.0 / (R_*T[i]);
+  }
+}
+
+void EOSIdealGas::MassDensityBatch(int n, const double* T, const double* p,
+        double* dens, double* d_dens_dT, double* d_dens_dp) {
+  MolarDensityBatch(n, T, p, dens, d_dens_dT, d_dens_dp);
+  ScaleBatch_(n, M_, dens, d_dens_dT, d_dens_dp);
+}
+
+
 void EOSIdealGas::InitializeFromPlist_() {
   R_ = eos_plist_.get<double>("Ideal gas constant [J/mol-K]", 8.3144621);
 
@@ -29,6 +29,11 @@ public:
   virtual double DMolarDensityDT(std::vector<double>& params) override;
   virtual double DMolarDensityDp(std::vector<double>& params) override;
 
+  virtual void MassDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) override;
+  virtual void MolarDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) override;
+
 protected:
   virtual void InitializeFromPlist_();
 
@@ -35,6 +35,13 @@ public:
   double DMolarDensityDT(std::vector<double>& params);
   double DMolarDensityDp(std::vector<double>& params);
 
+  void MassDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) { AMANZI_ASSERT(0); }
+  void MolarDensityBatch(int n, const double* T, const double* p,
+          double* dens, double* d_dens_dT, double* d_dens_dp) {
+    gas_eos_->MolarDensityBatch(n, T, p, dens, d_dens_dT, d_dens_dp);
+  }
+
   bool IsConstantMolarMass() { return false; }
   double MolarMass() { AMANZI_ASSERT(0); return 0.0; }
 
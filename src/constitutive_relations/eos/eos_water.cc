@@ -73,5 +73,38 @@ double EOSWater::DMassDensityDp(std::vector<double>& params) {
 
 };
 
+
+void EOSWater::MassDensityBatch(int n, const double* T, const double* p,
+        double* dens, double* d_dens_dT, double* d_dens_dp) {
+  if (dens) {
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = ka_ + (kb_ + (kc_ + kd_*dT)*dT)*dT;
+      dens[i] = rho1bar * (1.0 + kalpha_*(std::max(p[i], 101325.) - kp0_));
+    }
+  }
+  if (d_dens_dT) {
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = kb_ + (2.0*kc_ + 3.0*kd_*dT)*dT;
+      d_dens_dT[i] = rho1bar * (1.0 + kalpha_*(std::max(p[i], 101325.) - kp0_));
+    }
+  }
+  if (d_dens_dp) {
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = ka_ + (kb_ + (kc_ + kd_*dT)*dT)*dT;
+      d_dens_dp[i] = p[i] < 101325. ? 0. : rho1bar * kalpha_;
+    }
+  }
+}
+
+
+void EOSWater::MolarDensityBatch(int n, const double* T, const double* p,
+        double* dens, double* d_dens_dT, double* d_dens_dp) {
+  MassDensityBatch(n, T, p, dens, d_dens_dT, d_dens_dp);
+  ScaleBatch_(n, 1.0/M_, dens, d_dens_dT, d_dens_dp);
+}
+
 } // namespace
 } // namespace
@@ -62,56 +62,34 @@ ColumnSumEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
   Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
   const Epetra_MultiVector& dep_c = *S->GetFieldData(dep_key_)->ViewComponent("cell", false);
 
-  if (cv_key_ != "") {
-    const Epetra_MultiVector& cv = *S->GetFieldData(cv_key_)->ViewComponent("cell", false);
-    const Epetra_MultiVector& surf_cv = *S->GetFieldData(surf_cv_key_)->ViewComponent("cell", false);
-
+  Teuchos::RCP<const AmanziMesh::Mesh> subsurf_mesh = S->GetMesh(domain_);
+  columns_.Build(*subsurf_mesh);
+  AMANZI_ASSERT(columns_.num_columns() == res_c.MyLength());
+
+  // Fold the volume and density factors into a single per-cell weight, so
+  // that the column sum is one pass.
+  int ncells = dep_c.MyLength();
+  bool weighted = cv_key_ != "" || molar_dens_key_ != "";
+  if (weighted) {
+    weight_.assign(ncells, 1.);
+    if (cv_key_ != "") {
+      const Epetra_MultiVector& cv = *S->GetFieldData(cv_key_)->ViewComponent("cell", false);
+      for (int c=0; c!=ncells; ++c) weight_[c] = cv[0][c];
+    }
     if (molar_dens_key_ != "") {
       const Epetra_MultiVector& dens = *S->GetFieldData(molar_dens_key_)->ViewComponent("cell",false);
-
-      Teuchos::RCP<const AmanziMesh::Mesh> subsurf_mesh = S->GetMesh(domain_);
-      for (int c=0; c!=res_c.MyLength(); ++c) {
-        double sum = 0;
-        for (auto i : subsurf_mesh->cells_of_column(c)) {
-          sum += dep_c[0][i] * cv[0][i] / dens[0][i];
-        }
-        res_c[0][c] = coef_ * sum / surf_cv[0][c];
-      }
-    } else {
-
-      Teuchos::RCP<const AmanziMesh::Mesh> subsurf_mesh = S->GetMesh(domain_);
-      for (int c=0; c!=res_c.MyLength(); ++c) {
-        double sum = 0;
-        for (auto i : subsurf_mesh->cells_of_column(c)) {
-          sum += dep_c[0][i] * cv[0][i];
-        }
-        res_c[0][c] = coef_ * sum / surf_cv[0][c];
-      }
+      for (int c=0; c!=ncells; ++c) weight_[c] /= dens[0][c];
     }
-
+    columns_.Sum(dep_c[0], weight_.data(), res_c[0]);
   } else {
-    if (molar_dens_key_ != "") {
-      const Epetra_MultiVector& dens = *S->GetFieldData(molar_dens_key_)->ViewComponent("cell",false);
+    columns_.Sum(dep_c[0], res_c[0]);
+  }
 
-      Teuchos::RCP<const AmanziMesh::Mesh> subsurf_mesh = S->GetMesh(domain_);
-      for (int c=0; c!=res_c.MyLength(); ++c) {
-        double sum = 0;
-        for (auto i : subsurf_mesh->cells_of_column(c)) {
-          sum += dep_c[0][i] / dens[0][i];
-        }
-        res_c[0][c] = coef_ * sum;
-      }
-    } else {
-
-      Teuchos::RCP<const AmanziMesh::Mesh> subsurf_mesh = S->GetMesh(domain_);
-      for (int c=0; c!=res_c.MyLength(); ++c) {
-        double sum = 0;
-        for (auto i : subsurf_mesh->cells_of_column(c)) {
-          sum += dep_c[0][i];
-        }
-        res_c[0][c] = coef_ * sum;
-      }
-    }
+  if (cv_key_ != "") {
+    const Epetra_MultiVector& surf_cv = *S->GetFieldData(surf_cv_key_)->ViewComponent("cell", false);
+    for (int sc=0; sc!=res_c.MyLength(); ++sc) res_c[0][sc] *= coef_ / surf_cv[0][sc];
+  } else {
+    res_c.Scale(coef_);
   }
 }
 
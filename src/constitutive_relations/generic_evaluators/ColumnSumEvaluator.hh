@@ -41,8 +41,11 @@ of summing fluxes onto the surface and converting to m/s instead of mol/m^2/s).
 
 #pragma once
 
+#include <vector>
+
 #include "Factory.hh"
 #include "secondary_variable_field_evaluator.hh"
+#include "column_index.hh"
 
 namespace Amanzi {
 namespace Relations {
@@ -77,6 +80,11 @@ protected:
   Key surf_domain_;
 
   bool updated_once_;
+
+  // column-major index of the subsurface mesh, and per-cell weights
+  Operators::ColumnIndex columns_;
+  std::vector<double> weight_;
+
 private:
   static Utils::RegisteredFactory<FieldEvaluator,ColumnSumEvaluator> factory_;
 
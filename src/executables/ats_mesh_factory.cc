@@ -473,6 +473,99 @@ createMeshColumnSurface(const std::string& mesh_name,
 }
 
 
+//
+// Can a domain set be created by createMeshColumnsFromSpec()?  True if every
+// subdomain is a column created from the "*" spec, indexed by entity.
+//
+bool
+isSharedSpecColumnDomainSet(const std::string& mesh_name,
+                            Teuchos::ParameterList& ds_list)
+{
+  std::string star_name = Keys::getDomainInSet(mesh_name, "*");
+  if (!ds_list.isSublist(star_name)) return false;
+  auto& star_list = ds_list.sublist(star_name);
+  if (star_list.get<std::string>("mesh type") != "column") return false;
+
+  // a fixed entity overrides the indexing entity
+  if (star_list.isSublist("column parameters") &&
+      star_list.sublist("column parameters").isParameter("entity LID")) return false;
+
+  // any subdomain-specific spec forces the general path
+  for (const auto& entry : ds_list) {
+    if (entry.first == star_name || !ds_list.isSublist(entry.first)) continue;
+    KeyTriple dset;
+    if (Keys::splitDomainSet(entry.first, dset) && std::get<0>(dset) == mesh_name) return false;
+  }
+  return true;
+}
+
+
+//
+// Create all columns of a domain set from the shared "*" spec.
+//
+// This is equivalent to calling createMeshColumn() for each entity, and each
+// column is still extracted, given its own copy of the parent's parameter
+// list, and mapped to the parent on its own.  It only avoids copying and
+// re-reading the spec, and dispatching through createMesh(), per column.
+//
+// Not collective -- Column meshes are serial.
+void
+createMeshColumnsFromSpec(const std::string& mesh_name,
+                          const Teuchos::ParameterList& column_list,
+                          const std::string& indexing_parent_name,
+                          const std::vector<int>& lids,
+                          const std::vector<int>& gids,
+                          bool create_reference_maps,
+                          State& S,
+                          VerboseObject& vo,
+                          std::vector<std::string>& subdomains,
+                          std::map<std::string, Teuchos::RCP<const std::vector<int>>>& reference_maps)
+{
+  Teuchos::ParameterList mesh_plist(column_list);
+  Teuchos::ParameterList& mesh_column_plist = mesh_plist.sublist("column parameters");
+  auto parent_name = mesh_column_plist.get<std::string>("parent domain", indexing_parent_name);
+  bool deformable = mesh_plist.get<bool>("deformable mesh", false);
+  std::string columns_regionname;
+  if (mesh_plist.isParameter("build columns from set"))
+    columns_regionname = mesh_plist.get<std::string>("build columns from set");
+  bool build_columns = mesh_plist.get("build columns", false);
+
+  auto parent = S.GetMesh(parent_name);
+
+  if (vo.os_OK(Teuchos::VERB_HIGH)) {
+    *vo.os() << "  Constructing " << lids.size() << " MeshColumns of domain set "
+             << mesh_name << " with parent " << parent_name << std::endl;
+  }
+
+  subdomains.reserve(subdomains.size() + lids.size());
+  for (int i=0; i!=lids.size(); ++i) {
+    std::string subdomain = std::to_string(gids[i]);
+    std::string full_subdomain_name = Keys::getDomainInSet(mesh_name, subdomain);
+
+    auto parent_list = Teuchos::rcp(new Teuchos::ParameterList(*parent->parameter_list()));
+    auto mesh = AmanziMesh::createColumnMesh(parent, lids[i], parent_list);
+    if (mesh != Teuchos::null) {
+      if (!columns_regionname.empty()) {
+        mesh->build_columns(columns_regionname);
+      } else if (build_columns) {
+        mesh->build_columns();
+      }
+      checkVerifyMesh(mesh_plist, mesh);
+    }
+    S.RegisterMesh(full_subdomain_name, mesh, deformable);
+    subdomains.push_back(subdomain);
+
+    if (create_reference_maps)
+      reference_maps[full_subdomain_name] = AmanziMesh::createMapToParent(*mesh);
+
+    if (vo.os_OK(Teuchos::VERB_EXTREME)) {
+      *vo.os() << "  Registered mesh \"" << full_subdomain_name << "\" based on column LID: "
+               << lids[i] << std::endl;
+    }
+  }
+}
+
+
 //
 // Create a collection of meshes indexed over a domain set.
 //
@@ -524,6 +617,11 @@ createDomainSetIndexed(const std::string& mesh_name_pristine,
   }
 
   Teuchos::ParameterList& ds_list = mesh_plist.sublist("domain set indexed parameters");
+  if (ds_list.get<bool>("flyweight mesh", false) && vo.os_OK(Teuchos::VERB_LOW)) {
+    *vo.os() << vo.color("warning") << "Mesh \"" << mesh_name
+             << "\": \"flyweight mesh\" is not supported, so each subdomain is created as a full mesh."
+             << vo.reset() << std::endl;
+  }
 
   // get the indexing info
   auto regions = ds_list.get<Teuchos::Array<std::string>>("regions").toVector();
@@ -547,20 +645,41 @@ createDomainSetIndexed(const std::string& mesh_name_pristine,
     // for each subdomain, create a referencing map, a map from subdomain to reference mesh
     std::vector<std::string> subdomains;
     std::vector<int> lids;
+    std::vector<int> gids;
     std::map<std::string, Teuchos::RCP<const std::vector<int>>> reference_maps;
 
     // if aliased, we deal with domain sets specially
     std::string alias_target;
 
-    // create the subdomains, indexed over entities
+    // collect the indexing entities
+    const auto& map = indexing_parent_mesh->map(entity_kind, false);
     for (const auto& region : regions) {
       AmanziMesh::Entity_ID_List region_ents;
       indexing_parent_mesh->get_set_entities(region, entity_kind, AmanziMesh::Parallel_type::OWNED, &region_ents);
-      const auto& map = indexing_parent_mesh->map(entity_kind, false);
-
       for (const AmanziMesh::Entity_ID& lid : region_ents) {
+        lids.push_back(lid);
+        gids.push_back(map.GID(lid));
+      }
+    }
+
+    Teuchos::RCP<Teuchos::Time> dset_timer =
+        Teuchos::TimeMonitor::getNewCounter("domain set mesh creation");
+    Teuchos::TimeMonitor monitor(*dset_timer);
+    Teuchos::Time local_timer("domain set");
+    local_timer.start();
+
+    if (isSharedSpecColumnDomainSet(mesh_name, ds_list)) {
+      // all subdomains are columns sharing one spec
+      createMeshColumnsFromSpec(mesh_name, ds_list.sublist(Keys::getDomainInSet(mesh_name, "*")),
+                                indexing_parent_name, lids, gids, is_reference_mesh, S, vo,
+                                subdomains, reference_maps);
+
+    } else {
+      // create the subdomains, indexed over entities
+      for (int i=0; i!=lids.size(); ++i) {
         // subdomain name
-        AmanziMesh::Entity_ID gid = map.GID(lid);
+        AmanziMesh::Entity_ID lid = lids[i];
+        AmanziMesh::Entity_ID gid = gids[i];
         std::string subdomain = std::to_string(gid);
         subdomains.push_back(subdomain);
         std::string full_subdomain_name = Keys::getDomainInSet(mesh_name, subdomain);
@@ -614,6 +733,12 @@ createDomainSetIndexed(const std::string& mesh_name_pristine,
       }
     }
 
+    local_timer.stop();
+    if (vo.os_OK(Teuchos::VERB_LOW)) {
+      *vo.os() << "Domain set \"" << mesh_name << "\": created " << subdomains.size()
+               << " meshes in " << local_timer.totalElapsedTime() << " [s]" << std::endl;
+    }
+
     // construct and register the domain set
     Teuchos::RCP<AmanziMesh::DomainSet> ds = Teuchos::null;
     if (is_reference_mesh) {
@@ -243,7 +243,12 @@ Specified by `"mesh type`" of `"subgrid`".
       region (usually `"cell`") on which each subgrid mesh will be associated.
     * `"parent domain`" ``[string]`` **domain** Mesh which includes the above region.
     * `"flyweight mesh`" ``[bool]`` **False** NOT YET SUPPORTED.  Allows a single
-      mesh instead of one per entity.
+      mesh instead of one per entity, e.g. columns of equal numbers of cells
+      sharing topology and storing only their own coordinates.  Each subgrid
+      mesh is currently a full mesh, and setting this to true only warns.
+
+    Time spent creating domain set meshes is reported in the `"domain set
+    mesh creation`" timer.
 
 .. todo::
    WIP: Add examples (intermediate scale model, transport subgrid model)
@@ -371,6 +376,22 @@ createMeshColumnSurface(const std::string& mesh_name,
                         Amanzi::State& S,
                         Amanzi::VerboseObject& vo);
 
+bool
+isSharedSpecColumnDomainSet(const std::string& mesh_name,
+                            Teuchos::ParameterList& ds_list);
+
+void
+createMeshColumnsFromSpec(const std::string& mesh_name,
+                          const Teuchos::ParameterList& column_list,
+                          const std::string& indexing_parent_name,
+                          const std::vector<int>& lids,
+                          const std::vector<int>& gids,
+                          bool create_reference_maps,
+                          Amanzi::State& S,
+                          Amanzi::VerboseObject& vo,
+                          std::vector<std::string>& subdomains,
+                          std::map<std::string, Teuchos::RCP<const std::vector<int>>>& reference_maps);
+
 void
 createDomainSetIndexed(const std::string& mesh_name_pristine,
                        Teuchos::ParameterList& mesh_plist,
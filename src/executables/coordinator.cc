@@ -55,6 +55,7 @@ Coordinator::Coordinator(Teuchos::ParameterList& parameter_list,
   timer_ = Teuchos::rcp(new Teuchos::Time("wallclock_monitor",true));
   setup_timer_ = Teuchos::TimeMonitor::getNewCounter("setup");
   cycle_timer_ = Teuchos::TimeMonitor::getNewCounter("cycle");
+  commit_timer_ = Teuchos::TimeMonitor::getNewCounter("state commit");
   coordinator_init();
 
   vo_ = Teuchos::rcp(new Amanzi::VerboseObject("Coordinator", *parameter_list_));
@@ -502,8 +503,11 @@ bool Coordinator::advance(double t_old, double t_new, double& dt_next) {
     checkpoint(dt_next); // checkpoint with the new dt
 
     // we're done with this time step, copy the state
-    *S_ = *S_next_;
-    *S_inter_ = *S_next_;
+    {
+      Teuchos::TimeMonitor monitor(*commit_timer_);
+      *S_ = *S_next_;
+      if (S_inter_ != S_) *S_inter_ = *S_next_;
+    }
 
     if (vo_->os_OK(Teuchos::VERB_LOW))
       *vo_->os() << vo_->color("good") << "successful cycle" << vo_->reset() << std::endl;
@@ -514,8 +518,11 @@ bool Coordinator::advance(double t_old, double t_new, double& dt_next) {
     for (const auto& vis : failed_visualization_) WriteVis(*vis, *S_next_);
 
     // The timestep sizes have been updated, so copy back old soln and try again.
-    *S_next_ = *S_;
-    *S_inter_ = *S_;
+    {
+      Teuchos::TimeMonitor monitor(*commit_timer_);
+      *S_next_ = *S_;
+      if (S_inter_ != S_) *S_inter_ = *S_;
+    }
 
     // check whether meshes are deformable, and if so, recover the old coordinates
     for (Amanzi::State::mesh_iterator mesh=S_->mesh_begin();
@@ -162,6 +162,7 @@ private:
   // timers
   Teuchos::RCP<Teuchos::Time> setup_timer_;
   Teuchos::RCP<Teuchos::Time> cycle_timer_;
+  Teuchos::RCP<Teuchos::Time> commit_timer_;
   Teuchos::RCP<Teuchos::Time> timer_;
   double duration_;
   bool subcycled_ts_;
@@ -0,0 +1,113 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// Boundary face topology of a mesh, as flat index tables.
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#include "Teuchos_RCP.hpp"
+#include "errors.hh"
+#include "boundary_face_index.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+BoundaryFaceIndex::BoundaryFaceIndex(const AmanziMesh::Mesh& mesh)
+  : fmap_(mesh.face_map(true)),
+    bfmap_(mesh.exterior_face_map(true))
+{
+  const Epetra_Map& fmap = fmap_;
+  const Epetra_Map& bfmap = bfmap_;
+  nbf_owned_ = mesh.exterior_face_map(false).NumMyElements();
+
+  int nbf = bfmap.NumMyElements();
+  int nf = fmap.NumMyElements();
+  face_.resize(nbf);
+  cell_.resize(nbf);
+  dir_.resize(nbf);
+  bface_.assign(nf, -1);
+
+  AmanziMesh::Entity_ID_List cells, faces;
+  std::vector<int> dirs;
+  for (int bf=0; bf!=nbf; ++bf) {
+    AmanziMesh::Entity_ID f = fmap.LID(bfmap.GID(bf));
+    if (f < 0) {
+      Errors::Message msg;
+      msg << "BoundaryFaceIndex: boundary face GID " << bfmap.GID(bf)
+          << " is not a face of the mesh.";
+      Exceptions::amanzi_throw(msg);
+    }
+    face_[bf] = f;
+    bface_[f] = bf;
+
+    mesh.face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
+    if (cells.size() == 1) {
+      cell_[bf] = cells[0];
+      mesh.cell_get_faces_and_dirs(cells[0], &faces, &dirs);
+      dir_[bf] = dirs[std::find(faces.begin(), faces.end(), f) - faces.begin()];
+    } else {
+      cell_[bf] = -1;
+      dir_[bf] = 0;
+    }
+  }
+}
+
+
+bool
+BoundaryFaceIndex::Matches_(const AmanziMesh::Mesh& mesh) const
+{
+  // Map data is shared by copies of a map and freed with the last one.  As
+  // this object holds copies, the data of these maps cannot be freed and
+  // reallocated for another mesh, so comparing its address is exact.
+  return fmap_.DataPtr() == mesh.face_map(true).DataPtr() &&
+    bfmap_.DataPtr() == mesh.exterior_face_map(true).DataPtr();
+}
+
+
+bool
+BoundaryFaceIndex::Orphaned_() const
+{
+  // only this object's copies reference the map data, so the mesh is gone
+  return fmap_.DataPtr()->ReferenceCount() == 1 ||
+    bfmap_.DataPtr()->ReferenceCount() == 1;
+}
+
+
+const BoundaryFaceIndex&
+BoundaryFaceIndex::Get(const AmanziMesh::Mesh& mesh)
+{
+  static std::mutex cache_mutex;
+  static std::map<const AmanziMesh::Mesh*, Teuchos::RCP<BoundaryFaceIndex> > cache;
+  static std::size_t sweep_size = 16;
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto entry = cache.find(&mesh);
+  if (entry != cache.end() && entry->second->Matches_(mesh)) return *entry->second;
+
+  // Drop the entries of freed meshes.  This is done each time the cache
+  // doubles, so that building one entry per column mesh stays linear.
+  if (cache.size() >= sweep_size) {
+    for (auto other = cache.begin(); other != cache.end(); ) {
+      if (other->first != &mesh && other->second->Orphaned_()) {
+        other = cache.erase(other);
+      } else {
+        ++other;
+      }
+    }
+    sweep_size = std::max<std::size_t>(2 * cache.size(), 16);
+  }
+
+  auto& index = cache[&mesh];
+  index = Teuchos::rcp(new BoundaryFaceIndex(mesh));
+  return *index;
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,88 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// Boundary face topology of a mesh, as flat index tables.
+//
+// Translating between face and boundary face ids through the mesh's maps,
+// fmap.LID(bfmap.GID(bf)), is a pair of hash lookups, and finding the cell
+// internal to a boundary face or the face's direction relative to that cell
+// allocates lists of cells and faces.  Boundary conditions and boundary face
+// values do this for every boundary face on every residual evaluation.
+//
+// This object stores, for all (owned and ghosted) boundary faces:
+//   bf -> f, the face id of the boundary face
+//   f -> bf, the boundary face id of the face, or -1 if it is not one
+//   bf -> c, the cell internal to the boundary face
+//   bf -> dir, the direction of the face relative to that cell, which is
+//      +1 if the face normal points out of the domain
+// so that all of these are array loads.  Owned ids come first, so that owned
+// boundary faces and owned faces index the same tables.
+//
+// The tables are topological, and are built once per mesh on first use by
+// Get().  The shared cache is guarded by a lock, so Get() may be called from
+// threaded regions, but hot loops should call it once and keep the reference.
+// Entries hold a reference to the mesh's face maps and are matched on the
+// map data, so a new mesh allocated at a freed mesh's address is rebuilt.
+// Entries whose maps are no longer referenced by anything else, i.e. whose
+// mesh has been freed, are dropped as the cache grows.
+// -----------------------------------------------------------------------------
+
+#ifndef AMANZI_OPERATORS_BOUNDARY_FACE_INDEX_
+#define AMANZI_OPERATORS_BOUNDARY_FACE_INDEX_
+
+#include <vector>
+
+#include "Epetra_Map.h"
+#include "Mesh.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+class BoundaryFaceIndex {
+
+ public:
+  explicit BoundaryFaceIndex(const AmanziMesh::Mesh& mesh);
+
+  // The index of mesh, built on the first call for that mesh.
+  static const BoundaryFaceIndex& Get(const AmanziMesh::Mesh& mesh);
+
+  int num_boundary_faces(bool ghosted) const {
+    return ghosted ? face_.size() : nbf_owned_;
+  }
+
+  // face of a boundary face
+  AmanziMesh::Entity_ID face(AmanziMesh::Entity_ID bf) const { return face_[bf]; }
+
+  // boundary face of a face, or -1 if f is not on the boundary
+  AmanziMesh::Entity_ID boundary_face(AmanziMesh::Entity_ID f) const { return bface_[f]; }
+
+  // Cell internal to a boundary face.  This is -1 if the face does not have
+  // exactly one cell, which may be the case for ghosted faces.
+  AmanziMesh::Entity_ID cell(AmanziMesh::Entity_ID bf) const { return cell_[bf]; }
+
+  // direction of a boundary face relative to its internal cell, or 0 if it
+  // has no internal cell
+  int direction(AmanziMesh::Entity_ID bf) const { return dir_[bf]; }
+
+ private:
+  bool Matches_(const AmanziMesh::Mesh& mesh) const;
+  bool Orphaned_() const;
+
+ private:
+  Epetra_Map fmap_;                           // maps the tables were built from
+  Epetra_Map bfmap_;
+  int nbf_owned_;
+  std::vector<AmanziMesh::Entity_ID> face_;   // all boundary faces
+  std::vector<AmanziMesh::Entity_ID> bface_;  // all faces
+  std::vector<AmanziMesh::Entity_ID> cell_;   // all boundary faces
+  std::vector<int> dir_;                      // all boundary faces
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,123 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// Column-major indexing of the cells and faces of a columnar mesh.
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "errors.hh"
+#include "column_index.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+bool
+ColumnIndex::IsBuiltFor(const AmanziMesh::Mesh& mesh) const
+{
+  // held copies keep the map data alive, so its address is unique to mesh
+  return cell_map_ != Teuchos::null &&
+    cell_map_->DataPtr() == mesh.cell_map(false).DataPtr() &&
+    face_map_->DataPtr() == mesh.face_map(false).DataPtr();
+}
+
+
+void
+ColumnIndex::Build(const AmanziMesh::Mesh& mesh)
+{
+  if (IsBuiltFor(mesh)) return;
+
+  int ncols = mesh.num_columns(false);
+  cell_offsets_.resize(ncols+1);
+  cell_offsets_[0] = 0;
+  for (int col=0; col!=ncols; ++col) {
+    cell_offsets_[col+1] = cell_offsets_[col] + mesh.cells_of_column(col).size();
+  }
+
+  cells_.resize(cell_offsets_[ncols]);
+  faces_.resize(cell_offsets_[ncols] + ncols);
+  for (int col=0; col!=ncols; ++col) {
+    const auto& col_cells = mesh.cells_of_column(col);
+    const auto& col_faces = mesh.faces_of_column(col);
+    if (col_faces.size() != col_cells.size() + 1) {
+      Errors::Message msg;
+      msg << "ColumnIndex: column " << col << " has " << col_cells.size()
+          << " cells but " << col_faces.size() << " faces.";
+      Exceptions::amanzi_throw(msg);
+    }
+    std::copy(col_cells.begin(), col_cells.end(), cells_.begin() + cell_offsets_[col]);
+    std::copy(col_faces.begin(), col_faces.end(), faces_.begin() + cell_offsets_[col] + col);
+  }
+
+  cell_map_ = Teuchos::rcp(new Epetra_Map(mesh.cell_map(false)));
+  face_map_ = Teuchos::rcp(new Epetra_Map(mesh.face_map(false)));
+}
+
+
+void
+ColumnIndex::Gather(const double* field, double* buffer) const
+{
+  int n = num_cells();
+  for (int k=0; k!=n; ++k) buffer[k] = field[cells_[k]];
+}
+
+
+void
+ColumnIndex::Scatter(const double* buffer, double* field) const
+{
+  int n = num_cells();
+  for (int k=0; k!=n; ++k) field[cells_[k]] = buffer[k];
+}
+
+
+void
+ColumnIndex::Sum(const double* field, double* result) const
+{
+  int ncols = num_columns();
+  for (int col=0; col!=ncols; ++col) {
+    double sum = 0.;
+    for (int k=cell_offsets_[col]; k!=cell_offsets_[col+1]; ++k) {
+      sum += field[cells_[k]];
+    }
+    result[col] = sum;
+  }
+}
+
+
+void
+ColumnIndex::Sum(const double* field, const double* weight, double* result) const
+{
+  int ncols = num_columns();
+  for (int col=0; col!=ncols; ++col) {
+    double sum = 0.;
+    for (int k=cell_offsets_[col]; k!=cell_offsets_[col+1]; ++k) {
+      int c = cells_[k];
+      sum += field[c] * weight[c];
+    }
+    result[col] = sum;
+  }
+}
+
+
+void
+ColumnIndex::Average(const double* field, const double* weight, double* result) const
+{
+  int ncols = num_columns();
+  for (int col=0; col!=ncols; ++col) {
+    double sum = 0.;
+    double wsum = 0.;
+    for (int k=cell_offsets_[col]; k!=cell_offsets_[col+1]; ++k) {
+      int c = cells_[k];
+      sum += field[c] * weight[c];
+      wsum += weight[c];
+    }
+    result[col] = wsum > 0. ? sum / wsum : 0.;
+  }
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,124 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// Column-major indexing of the cells and faces of a columnar mesh.
+//
+// The cells of each owned column, ordered top to bottom, are concatenated
+// into a single permutation with CSR offsets, and likewise the faces of each
+// column (one more per column than cells, the first being the top face).
+// These are built once per mesh from Mesh::cells_of_column() and
+// Mesh::faces_of_column(), which requires that the mesh has built columns.
+// The index is topological, and so is not invalidated by mesh deformation.
+// As in BoundaryFaceIndex, it holds copies of the mesh's cell and face maps
+// and is matched on their data, so a new mesh allocated at a freed mesh's
+// address is not mistaken for the old one.
+//
+// Column diagnostics are then single streaming passes over the permutation,
+// rather than a walk through the mesh's per-column lists.  Fields may also be
+// gathered into, and scattered from, contiguous column-major buffers.
+// -----------------------------------------------------------------------------
+
+#ifndef AMANZI_OPERATORS_COLUMN_INDEX_
+#define AMANZI_OPERATORS_COLUMN_INDEX_
+
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Epetra_Map.h"
+#include "Mesh.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+class ColumnIndex {
+
+ public:
+  ColumnIndex() {}
+
+  // Builds the index for the owned columns of mesh, if not already built for
+  // this mesh.
+  void Build(const AmanziMesh::Mesh& mesh);
+  bool IsBuiltFor(const AmanziMesh::Mesh& mesh) const;
+
+  int num_columns() const { return cell_offsets_.size() - 1; }
+  int num_cells() const { return cells_.size(); }
+  int num_cells(int col) const { return cell_offsets_[col+1] - cell_offsets_[col]; }
+
+  // cells of a column, top to bottom
+  const int* cells(int col) const { return &cells_[cell_offsets_[col]]; }
+
+  // faces of a column, top to bottom, so that cells(col)[i] is between
+  // faces(col)[i] and faces(col)[i+1]
+  const int* faces(int col) const { return &faces_[cell_offsets_[col] + col]; }
+
+  // Offset of a column's first cell in column-major buffers.
+  int offset(int col) const { return cell_offsets_[col]; }
+
+  // Gathers a cell field into a column-major buffer of length num_cells(),
+  // and scatters it back.
+  void Gather(const double* field, double* buffer) const;
+  void Scatter(const double* buffer, double* field) const;
+
+  // Per-column sums, one value per column in result:
+  //   sum_i field_i, or sum_i field_i * weight_i
+  void Sum(const double* field, double* result) const;
+  void Sum(const double* field, const double* weight, double* result) const;
+
+  // Per-column weighted averages, sum_i field_i w_i / sum_i w_i.  Columns of
+  // zero total weight are assigned 0.
+  void Average(const double* field, const double* weight, double* result) const;
+
+  // Index within the column of the first cell, from the top, at which pred
+  // holds, or -1 if it holds nowhere in the column.
+  template<typename Predicate>
+  void FirstCrossing(const double* field, const Predicate& pred, int* result) const {
+    int ncols = num_columns();
+    for (int col=0; col!=ncols; ++col) {
+      int k0 = cell_offsets_[col];
+      int k1 = cell_offsets_[col+1];
+      int found = -1;
+      for (int k=k0; k!=k1; ++k) {
+        if (pred(field[cells_[k]])) {
+          found = k - k0;
+          break;
+        }
+      }
+      result[col] = found;
+    }
+  }
+
+  // Index within the column of the deepest cell at which pred holds, or -1
+  // if it holds nowhere in the column.
+  template<typename Predicate>
+  void DeepestCrossing(const double* field, const Predicate& pred, int* result) const {
+    int ncols = num_columns();
+    for (int col=0; col!=ncols; ++col) {
+      int k0 = cell_offsets_[col];
+      int found = -1;
+      for (int k=cell_offsets_[col+1]-1; k>=k0; --k) {
+        if (pred(field[cells_[k]])) {
+          found = k - k0;
+          break;
+        }
+      }
+      result[col] = found;
+    }
+  }
+
+ private:
+  Teuchos::RCP<const Epetra_Map> cell_map_;  // maps the index was built from
+  Teuchos::RCP<const Epetra_Map> face_map_;
+
+  std::vector<int> cell_offsets_;  // num_columns() + 1
+  std::vector<int> cells_;         // column-major cell ids
+  std::vector<int> faces_;         // column-major face ids, offset by col
+};
+
+} // namespace
+} // namespace
+
+#endif
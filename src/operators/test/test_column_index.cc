@@ -0,0 +1,133 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+*/
+
+// Checks ColumnIndex against the mesh's own column lists on a 2x2x4 box.
+
+#include <vector>
+#include "UnitTest++.h"
+
+#include "AmanziComm.hh"
+#include "MeshFactory.hh"
+#include "column_index.hh"
+
+using namespace Amanzi;
+
+struct ColumnMesh {
+  ColumnMesh() {
+    auto comm = getCommSelf();
+    AmanziMesh::MeshFactory meshfactory(comm);
+    mesh = meshfactory.create(0.0, 0.0, 0.0, 2.0, 2.0, 4.0, 2, 2, 4);
+    mesh->build_columns();
+    ncells = mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+
+    // cell centroid elevations
+    z.resize(ncells);
+    for (int c=0; c!=ncells; ++c) z[c] = mesh->cell_centroid(c)[2];
+  }
+
+  Teuchos::RCP<AmanziMesh::Mesh> mesh;
+  int ncells;
+  std::vector<double> z;
+};
+
+
+TEST_FIXTURE(ColumnMesh, COLUMN_INDEX_BUILD) {
+  Operators::ColumnIndex columns;
+  CHECK(!columns.IsBuiltFor(*mesh));
+  columns.Build(*mesh);
+  CHECK(columns.IsBuiltFor(*mesh));
+
+  CHECK_EQUAL(4, columns.num_columns());
+  CHECK_EQUAL(16, columns.num_cells());
+  for (int col=0; col!=columns.num_columns(); ++col) {
+    const auto& cells = mesh->cells_of_column(col);
+    const auto& faces = mesh->faces_of_column(col);
+    CHECK_EQUAL(4, columns.num_cells(col));
+    CHECK_EQUAL(4*col, columns.offset(col));
+    for (int i=0; i!=4; ++i) CHECK_EQUAL(cells[i], columns.cells(col)[i]);
+    for (int i=0; i!=5; ++i) CHECK_EQUAL(faces[i], columns.faces(col)[i]);
+
+    // top to bottom
+    for (int i=1; i!=4; ++i) CHECK(z[columns.cells(col)[i]] < z[columns.cells(col)[i-1]]);
+  }
+
+  // another mesh of the same shape is not the same mesh
+  AmanziMesh::MeshFactory meshfactory(getCommSelf());
+  auto other = meshfactory.create(0.0, 0.0, 0.0, 2.0, 2.0, 4.0, 2, 2, 4);
+  CHECK(!columns.IsBuiltFor(*other));
+}
+
+
+TEST_FIXTURE(ColumnMesh, COLUMN_INDEX_GATHER_SCATTER) {
+  Operators::ColumnIndex columns;
+  columns.Build(*mesh);
+
+  std::vector<double> field(ncells), buffer(ncells), result(ncells, -1.);
+  for (int c=0; c!=ncells; ++c) field[c] = c;
+
+  columns.Gather(field.data(), buffer.data());
+  for (int col=0; col!=columns.num_columns(); ++col) {
+    for (int i=0; i!=columns.num_cells(col); ++i) {
+      CHECK_EQUAL(columns.cells(col)[i], buffer[columns.offset(col) + i]);
+    }
+  }
+
+  columns.Scatter(buffer.data(), result.data());
+  for (int c=0; c!=ncells; ++c) CHECK_EQUAL(field[c], result[c]);
+}
+
+
+TEST_FIXTURE(ColumnMesh, COLUMN_INDEX_SUM_AVERAGE) {
+  Operators::ColumnIndex columns;
+  columns.Build(*mesh);
+  int ncols = columns.num_columns();
+
+  // cell centroids are at z = 0.5, 1.5, 2.5, 3.5 in every column
+  std::vector<double> ones(ncells, 1.), twos(ncells, 2.), result(ncols);
+  columns.Sum(z.data(), result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_CLOSE(8.0, result[col], 1.e-12);
+
+  columns.Sum(z.data(), twos.data(), result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_CLOSE(16.0, result[col], 1.e-12);
+
+  columns.Average(z.data(), ones.data(), result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_CLOSE(2.0, result[col], 1.e-12);
+
+  // weighted toward the top cell
+  std::vector<double> weight(ncells, 0.);
+  for (int col=0; col!=ncols; ++col) {
+    weight[columns.cells(col)[0]] = 3.;
+    weight[columns.cells(col)[1]] = 1.;
+  }
+  columns.Average(z.data(), weight.data(), result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_CLOSE((3*3.5 + 2.5) / 4., result[col], 1.e-12);
+
+  // zero total weight
+  std::vector<double> zeros(ncells, 0.);
+  columns.Average(z.data(), zeros.data(), result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_EQUAL(0., result[col]);
+}
+
+
+TEST_FIXTURE(ColumnMesh, COLUMN_INDEX_CROSSINGS) {
+  Operators::ColumnIndex columns;
+  columns.Build(*mesh);
+  int ncols = columns.num_columns();
+  std::vector<int> result(ncols);
+
+  // from the top, z = 3.5, 2.5, 1.5, 0.5
+  columns.FirstCrossing(z.data(), [](double zc) { return zc < 2.; }, result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_EQUAL(2, result[col]);
+
+  columns.DeepestCrossing(z.data(), [](double zc) { return zc > 2.; }, result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_EQUAL(1, result[col]);
+
+  columns.FirstCrossing(z.data(), [](double zc) { return zc > 10.; }, result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_EQUAL(-1, result[col]);
+
+  columns.DeepestCrossing(z.data(), [](double zc) { return zc > 10.; }, result.data());
+  for (int col=0; col!=ncols; ++col) CHECK_EQUAL(-1, result[col]);
+}
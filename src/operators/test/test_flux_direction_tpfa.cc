@@ -0,0 +1,125 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+*/
+
+// Checks that the two-point flux estimate has the sign of the diffusion
+// operator's flux on a K-orthogonal mesh: a Cartesian box with a diagonal,
+// anisotropic permeability.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "AmanziComm.hh"
+#include "MeshFactory.hh"
+#include "CompositeVector.hh"
+#include "BCs.hh"
+#include "OperatorDefs.hh"
+#include "PDE_DiffusionFactory.hh"
+#include "PDE_Diffusion.hh"
+#include "flux_direction_tpfa.hh"
+
+using namespace Amanzi;
+
+TEST(FLUX_DIRECTION_TPFA_SIGNS) {
+  AmanziMesh::MeshFactory meshfactory(getCommSelf());
+  auto mesh = meshfactory.create(0.0, 0.0, 0.0, 4.0, 2.0, 3.0, 4, 2, 6);
+
+  int ncells_owned = mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+  int nfaces_owned = mesh->num_entities(AmanziMesh::FACE, AmanziMesh::Parallel_type::OWNED);
+  int nfaces = mesh->num_entities(AmanziMesh::FACE, AmanziMesh::Parallel_type::ALL);
+
+  AmanziGeometry::Point g(0., 0., -9.80665);
+
+  auto K = Teuchos::rcp(new std::vector<WhetStone::Tensor>(ncells_owned));
+  for (auto& Kc : *K) {
+    Kc.Init(3, 2);
+    Kc(0,0) = 3.e-12;
+    Kc(1,1) = 1.e-12;
+    Kc(2,2) = 2.e-13;
+  }
+
+  // a hydrostatic pressure, perturbed so that fluxes go every which way
+  CompositeVectorSpace cvs;
+  cvs.SetMesh(mesh)->SetGhosted()->SetComponent("cell", AmanziMesh::CELL, 1);
+  auto pres = Teuchos::rcp(new CompositeVector(cvs));
+  auto rho = Teuchos::rcp(new CompositeVector(cvs));
+  {
+    Epetra_MultiVector& pres_c = *pres->ViewComponent("cell", false);
+    Epetra_MultiVector& rho_c = *rho->ViewComponent("cell", false);
+    for (int c=0; c!=ncells_owned; ++c) {
+      const auto& xc = mesh->cell_centroid(c);
+      rho_c[0][c] = 1000. - 2. * xc[0];
+      pres_c[0][c] = 101325. + 1000. * 9.80665 * (3.0 - xc[2])
+          + 3000. * std::sin(1.3 * xc[0] + 0.7 * xc[1]) * std::cos(0.9 * xc[2]);
+    }
+  }
+  pres->ScatterMasterToGhosted("cell");
+  rho->ScatterMasterToGhosted("cell");
+
+  // Dirichlet on x = 0, inflow on x = 4, no flow elsewhere
+  auto bc = Teuchos::rcp(new Operators::BCs(mesh, AmanziMesh::FACE, WhetStone::DOF_Type::SCALAR));
+  std::vector<int>& markers = bc->bc_model();
+  std::vector<double>& values = bc->bc_value();
+  for (int f=0; f!=nfaces; ++f) {
+    AmanziMesh::Entity_ID_List cells;
+    mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
+    if (cells.size() != 1) continue;
+    const auto& xf = mesh->face_centroid(f);
+    if (std::abs(xf[0]) < 1.e-10) {
+      markers[f] = Operators::OPERATOR_BC_DIRICHLET;
+      values[f] = 101325. + 1000. * 9.80665 * (3.0 - xf[2]) + 500.;
+    } else {
+      markers[f] = Operators::OPERATOR_BC_NEUMANN;
+      values[f] = std::abs(xf[0] - 4.0) < 1.e-10 ? -1.e-4 : 0.;
+    }
+  }
+
+  // the operator's flux, as in Richards' "diffusion operator" method
+  Teuchos::ParameterList olist;
+  olist.set("discretization primary", "fv: default");
+  olist.set("gravity", true);
+  olist.set("nonlinear coefficient", "none");
+  Operators::PDE_DiffusionFactory opfactory;
+  auto op = opfactory.CreateWithGravity(olist, mesh, bc);
+  op->SetGravity(g);
+  op->SetBCs(bc, bc);
+  op->SetTensorCoefficient(K);
+  op->SetScalarCoefficient(Teuchos::null, Teuchos::null);
+  op->SetDensity(rho);
+  op->UpdateMatrices(Teuchos::null, pres.ptr());
+  op->ApplyBCs(true, true, true);
+
+  CompositeVectorSpace fvs;
+  fvs.SetMesh(mesh)->SetGhosted()->SetComponent("face", AmanziMesh::FACE, 1);
+  CompositeVector flux_op(fvs), flux_tp(fvs);
+  op->UpdateFlux(pres.ptr(), Teuchos::ptr(&flux_op));
+
+  // the two-point estimate
+  Operators::FluxDirectionTPFA tpfa;
+  tpfa.Setup(*mesh, *K, g);
+  CHECK(tpfa.IsSetup());
+  Epetra_MultiVector& flux_tp_f = *flux_tp.ViewComponent("face", false);
+  int n_near_zero = tpfa.Compute(*pres->ViewComponent("cell", true),
+          *rho->ViewComponent("cell", true), markers, values, 0., flux_tp_f);
+  CHECK_EQUAL(0, n_near_zero);
+
+  const Epetra_MultiVector& flux_op_f = *flux_op.ViewComponent("face", false);
+  double qmax = 0.;
+  for (int f=0; f!=nfaces_owned; ++f) qmax = std::max(qmax, std::abs(flux_op_f[0][f]));
+  CHECK(qmax > 0.);
+
+  int n_compared = 0;
+  for (int f=0; f!=nfaces_owned; ++f) {
+    if (std::abs(flux_op_f[0][f]) < 1.e-8 * qmax) {
+      CHECK(std::abs(flux_tp_f[0][f]) < 1.e-6 * qmax);
+    } else {
+      CHECK(flux_op_f[0][f] * flux_tp_f[0][f] > 0.);
+      n_compared++;
+    }
+  }
+  CHECK(n_compared > nfaces_owned / 2);
+}
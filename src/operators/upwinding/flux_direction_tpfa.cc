@@ -0,0 +1,120 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// A two-point estimate of the Darcy flux, for use as an upwind direction.
+// -----------------------------------------------------------------------------
+
+#include <cmath>
+
+#include "OperatorDefs.hh"
+#include "flux_direction_tpfa.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+namespace {
+
+// Normal permeability over the distance from the cell centroid to the face,
+// i.e. the half transmissibility per unit area.
+double
+halfTransmissibility(const AmanziMesh::Mesh& mesh,
+                      const WhetStone::Tensor& K,
+                      AmanziMesh::Entity_ID c,
+                      const AmanziGeometry::Point& xf,
+                      const AmanziGeometry::Point& unit_normal)
+{
+  double kn = (K * unit_normal) * unit_normal;
+  double d = std::abs((xf - mesh.cell_centroid(c)) * unit_normal);
+  if (d <= 0.) d = AmanziGeometry::norm(xf - mesh.cell_centroid(c));
+  return kn / d;
+}
+
+} // namespace
+
+
+void
+FluxDirectionTPFA::Setup(const AmanziMesh::Mesh& mesh,
+                         const std::vector<WhetStone::Tensor>& K,
+                         const AmanziGeometry::Point& g)
+{
+  int ncells_owned = mesh.num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+  int nfaces_owned = mesh.num_entities(AmanziMesh::FACE, AmanziMesh::Parallel_type::OWNED);
+  cell0_.resize(nfaces_owned);
+  cell1_.resize(nfaces_owned);
+  trans_.resize(nfaces_owned);
+  dz_.resize(nfaces_owned);
+  area_dir_.resize(nfaces_owned);
+
+  AmanziMesh::Entity_ID_List cells;
+  for (int f=0; f!=nfaces_owned; ++f) {
+    mesh.face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
+    int dir;
+    const AmanziGeometry::Point& normal = mesh.face_normal(f, false, cells[0], &dir);
+    double area = mesh.face_area(f);
+    AmanziGeometry::Point unit_normal = normal / area;
+    const AmanziGeometry::Point& xf = mesh.face_centroid(f);
+
+    cell0_[f] = cells[0];
+    area_dir_[f] = area * dir;
+    if (cells.size() == 1) {
+      cell1_[f] = -1;
+      trans_[f] = dir * area * halfTransmissibility(mesh, K[cells[0]], cells[0], xf, unit_normal);
+      dz_[f] = g * (mesh.cell_centroid(cells[0]) - xf);
+    } else {
+      cell1_[f] = cells[1];
+      const WhetStone::Tensor& K0 = K[cells[0] < ncells_owned ? cells[0] : cells[1]];
+      const WhetStone::Tensor& K1 = K[cells[1] < ncells_owned ? cells[1] : cells[0]];
+      double t0 = halfTransmissibility(mesh, K0, cells[0], xf, unit_normal);
+      double t1 = halfTransmissibility(mesh, K1, cells[1], xf, unit_normal);
+      trans_[f] = dir * area * t0 * t1 / (t0 + t1);
+      dz_[f] = g * (mesh.cell_centroid(cells[0]) - mesh.cell_centroid(cells[1]));
+    }
+  }
+
+  mesh_ = &mesh;
+}
+
+
+int
+FluxDirectionTPFA::Compute(const Epetra_MultiVector& pres_c,
+                           const Epetra_MultiVector& rho_c,
+                           const std::vector<int>& bc_markers,
+                           const std::vector<double>& bc_values,
+                           double tol,
+                           Epetra_MultiVector& flux_f,
+                           std::vector<int>* near_zero) const
+{
+  if (near_zero) near_zero->clear();
+  int n_near_zero = 0;
+
+  int nfaces_owned = cell0_.size();
+  for (int f=0; f!=nfaces_owned; ++f) {
+    int c0 = cell0_[f];
+    int c1 = cell1_[f];
+    double q;
+    if (c1 >= 0) {
+      double rho = 0.5 * (rho_c[0][c0] + rho_c[0][c1]);
+      q = trans_[f] * (pres_c[0][c0] - pres_c[0][c1] - rho * dz_[f]);
+    } else if (bc_markers[f] == OPERATOR_BC_DIRICHLET) {
+      q = trans_[f] * (pres_c[0][c0] - bc_values[f] - rho_c[0][c0] * dz_[f]);
+    } else if (bc_markers[f] == OPERATOR_BC_NEUMANN) {
+      q = area_dir_[f] * bc_values[f];
+    } else {
+      q = 0.;
+    }
+    flux_f[0][f] = q;
+
+    if (std::abs(q) < tol) {
+      n_near_zero++;
+      if (near_zero) near_zero->push_back(f);
+    }
+  }
+  return n_near_zero;
+}
+
+} // namespace
+} // namespace
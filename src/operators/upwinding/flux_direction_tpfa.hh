@@ -0,0 +1,82 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// A two-point estimate of the Darcy flux, for use as an upwind direction.
+//
+// Upwinding on the total flux needs only the direction of the flux, but the
+// flux itself is computed by assembling the diffusion operator's local
+// matrices, applying boundary conditions, and calculating fluxes.  This
+// estimates the flux on each owned face instead by a two-point flux
+// approximation of -K (grad p - rho g), from the cell pressures and
+// densities:
+//
+//   q_f = T_f * [ (p_0 - p_1) - rho_f g . (x_0 - x_1) ]
+//
+// where the transmissibility T_f, signed by the face normal's orientation
+// relative to cell 0, is computed once from the permeability tensors and the
+// geometry.  On boundary faces, Dirichlet data provides p_1 at the face
+// centroid and Neumann data provides the flux directly; other boundary faces
+// have no flux.
+//
+// The estimate has the same sign as the operator's flux where the mesh is
+// K-orthogonal, and is otherwise only trusted where it is far from zero, so
+// faces with |q_f| below a tolerance are reported for the caller to recompute.
+// -----------------------------------------------------------------------------
+
+#ifndef AMANZI_UPWINDING_FLUX_DIRECTION_TPFA_
+#define AMANZI_UPWINDING_FLUX_DIRECTION_TPFA_
+
+#include <vector>
+
+#include "Epetra_MultiVector.h"
+
+#include "Point.hh"
+#include "Tensor.hh"
+#include "Mesh.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+class FluxDirectionTPFA {
+
+ public:
+  FluxDirectionTPFA() : mesh_(nullptr) {}
+
+  // Precomputes the face connectivity, transmissibilities, and gravitational
+  // potential differences.  K is the permeability on owned cells; faces
+  // between an owned and a ghosted cell use the owned cell's permeability on
+  // both sides.  This must be called again if K or the mesh geometry changes.
+  void Setup(const AmanziMesh::Mesh& mesh,
+             const std::vector<WhetStone::Tensor>& K,
+             const AmanziGeometry::Point& g);
+  bool IsSetup() const { return mesh_ != nullptr; }
+
+  // Estimates the flux on owned faces from ghosted cell pressures and
+  // densities, returning the number of faces for which |flux| < tol.  If
+  // near_zero is provided, those faces are listed in it.
+  int Compute(const Epetra_MultiVector& pres_c,
+              const Epetra_MultiVector& rho_c,
+              const std::vector<int>& bc_markers,
+              const std::vector<double>& bc_values,
+              double tol,
+              Epetra_MultiVector& flux_f,
+              std::vector<int>* near_zero=nullptr) const;
+
+ private:
+  const AmanziMesh::Mesh* mesh_;
+
+  // per owned face
+  std::vector<int> cell0_, cell1_;   // cell1_ is -1 on the boundary
+  std::vector<double> trans_;        // signed transmissibility
+  std::vector<double> dz_;           // g . (x_0 - x_1), or g . (x_0 - x_f)
+  std::vector<double> area_dir_;     // signed area, for Neumann data
+};
+
+} // namespace
+} // namespace
+
+#endif
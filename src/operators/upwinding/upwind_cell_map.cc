@@ -0,0 +1,65 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// Upwind and downwind cells of owned faces, given a flux.
+// -----------------------------------------------------------------------------
+
+#include "dbc.hh"
+#include "upwind_cell_map.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+void UpwindCellMap::Compute(const AmanziMesh::Mesh& mesh,
+                            const Epetra_MultiVector& flux) {
+  if (&mesh != mesh_) Build_(mesh);
+  AMANZI_ASSERT(flux.MyLength() == nfaces_);
+
+  const int* fc = face_cells_.data();
+  const int* fd = face_dirs_.data();
+  for (int f=0; f!=nfaces_; ++f) {
+    // the other cell, if any, sees the opposite orientation
+    double sign = flux[0][f] * fd[2*f];
+    if (sign < 0) {
+      uw_[f] = fc[2*f+1];
+      dw_[f] = fc[2*f];
+    } else {
+      uw_[f] = fc[2*f];
+      dw_[f] = fc[2*f+1];
+    }
+  }
+}
+
+
+void UpwindCellMap::Build_(const AmanziMesh::Mesh& mesh) {
+  mesh_ = &mesh;
+  nfaces_ = mesh.num_entities(AmanziMesh::FACE, AmanziMesh::Parallel_type::OWNED);
+  int ncells = mesh.num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::ALL);
+
+  face_cells_.assign(2*nfaces_, -1);
+  face_dirs_.assign(2*nfaces_, 0);
+  uw_.resize(nfaces_);
+  dw_.resize(nfaces_);
+
+  // Walk cells in order, so that the lower-numbered cell comes first.
+  AmanziMesh::Entity_ID_List faces;
+  std::vector<int> fdirs;
+  for (int c=0; c!=ncells; ++c) {
+    mesh.cell_get_faces_and_dirs(c, &faces, &fdirs);
+    for (unsigned int n=0; n!=faces.size(); ++n) {
+      int f = faces[n];
+      if (f < nfaces_) {
+        int slot = face_cells_[2*f] == -1 ? 2*f : 2*f+1;
+        face_cells_[slot] = c;
+        face_dirs_[slot] = fdirs[n];
+      }
+    }
+  }
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,57 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+//
+// Upwind and downwind cells of owned faces, given a flux.
+//
+// The face-to-cell connectivity, and the orientation of each face relative to
+// its cells, is built once per mesh and kept, so that the upwind cells can be
+// determined in a single pass over faces on each call.  The connectivity is
+// topological, and so is not invalidated by mesh deformation.
+// -----------------------------------------------------------------------------
+
+#ifndef AMANZI_UPWINDING_CELL_MAP_
+#define AMANZI_UPWINDING_CELL_MAP_
+
+#include <vector>
+
+#include "Epetra_MultiVector.h"
+#include "Mesh.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+class UpwindCellMap {
+
+ public:
+  UpwindCellMap() : mesh_(nullptr), nfaces_(0) {}
+
+  // Determines the upwind and downwind cells of all owned faces.  Either may
+  // be a ghost cell, and is -1 on the boundary.  Where the flux is zero, the
+  // lower-numbered cell is taken as upwind.
+  void Compute(const AmanziMesh::Mesh& mesh, const Epetra_MultiVector& flux);
+
+  int upwind(int f) const { return uw_[f]; }
+  int downwind(int f) const { return dw_[f]; }
+
+ private:
+  void Build_(const AmanziMesh::Mesh& mesh);
+
+  const AmanziMesh::Mesh* mesh_;
+  int nfaces_;
+
+  // two entries per face, -1 for a missing cell
+  std::vector<int> face_cells_;
+  std::vector<int> face_dirs_;
+
+  std::vector<int> uw_;
+  std::vector<int> dw_;
+};
+
+} // namespace
+} // namespace
+
+#endif
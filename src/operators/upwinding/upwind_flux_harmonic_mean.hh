@@ -14,6 +14,7 @@
 #define AMANZI_UPWINDING_FLUXHARMONICMEAN_SCHEME_
 
 #include "upwinding.hh"
+#include "upwind_cell_map.hh"
 
 namespace Amanzi {
 
@@ -58,6 +59,7 @@ private:
   std::string cell_coef_;
   std::string face_coef_;
   std::string flux_;
+  UpwindCellMap upwind_cells_;
   double flux_eps_;
 };
 
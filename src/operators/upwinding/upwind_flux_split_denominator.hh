@@ -13,6 +13,7 @@
 #define AMANZI_UPWINDING_FLUXSPLITDENOMINATOR_SCHEME_
 
 #include "upwinding.hh"
+#include "upwind_cell_map.hh"
 
 namespace Amanzi {
 
@@ -63,6 +64,7 @@ private:
   std::string cell_coef_;
   std::string face_coef_;
   std::string flux_;
+  UpwindCellMap upwind_cells_;
   double flux_eps_;
   std::string slope_;
   std::string manning_coef_;
@@ -16,7 +16,6 @@
 #include "Debugger.hh"
 #include "VerboseObject.hh"
 #include "upwind_total_flux.hh"
-#include "Epetra_IntVector.h"
 
 namespace Amanzi {
 namespace Operators {
@@ -63,49 +62,16 @@ void UpwindTotalFlux::CalculateCoefficientsOnFaces(
   Epetra_MultiVector& coef_faces = *face_coef->ViewComponent("face",false);
   const Epetra_MultiVector& coef_cells = *cell_coef.ViewComponent("cell",true);
 
-  // Identify upwind/downwind cells for each local face.  Note upwind/downwind
-  // may be a ghost cell.
-  Epetra_IntVector upwind_cell(*face_coef->ComponentMap("face",true));
-  upwind_cell.PutValue(-1);
-  Epetra_IntVector downwind_cell(*face_coef->ComponentMap("face",true));
-  downwind_cell.PutValue(-1);
-
-  AmanziMesh::Entity_ID_List faces;
-  std::vector<int> fdirs;
-  int nfaces_local = flux.size("face",false);
-
   bool has_cells = face_coef->HasComponent("cell");
-  Teuchos::RCP<Epetra_MultiVector> face_cell_coef;
-  if (has_cells)
-    face_cell_coef = face_coef->ViewComponent("cell", true);
-
-  int ncells = cell_coef.size("cell",true);
-  for (int c=0; c!=ncells; ++c) {
-    mesh->cell_get_faces_and_dirs(c, &faces, &fdirs);   
-
-    for (unsigned int n=0; n!=faces.size(); ++n) {
-      int f = faces[n];
-
-      if (has_cells) (*face_cell_coef)[0][c] = coef_cells[0][c];
-
-      if (f < nfaces_local) {
-        if (flux_v[0][f] * fdirs[n] > 0) {
-          upwind_cell[f] = c;
-        } else if (flux_v[0][f] * fdirs[n] < 0) {
-          downwind_cell[f] = c;
-        } else {
-          // We don't care, but we have to get one into upwind and the other
-          // into downwind.
-          if (upwind_cell[f] == -1) {
-            upwind_cell[f] = c;
-          } else {
-            downwind_cell[f] = c;
-          }
-        }
-      }
-    }
+  if (has_cells) {
+    Epetra_MultiVector& face_cell_coef = *face_coef->ViewComponent("cell", true);
+    face_cell_coef = coef_cells;
   }
 
+  // Identify upwind/downwind cells for each local face.  Note upwind/downwind
+  // may be a ghost cell.
+  upwind_cells_.Compute(*mesh, flux_v);
+
   // Determine the face coefficient of local faces.
   // These parameters may be key to a smooth convergence rate near zero flux.
   //  double flow_eps_factor = 1.;
@@ -114,8 +80,8 @@ void UpwindTotalFlux::CalculateCoefficientsOnFaces(
 
   int nfaces = face_coef->size("face",false);
   for (int f=0; f!=nfaces; ++f) {
-    int uw = upwind_cell[f];
-    int dw = downwind_cell[f];
+    int uw = upwind_cells_.upwind(f);
+    int dw = upwind_cells_.downwind(f);
     AMANZI_ASSERT(!((uw == -1) && (dw == -1)));
 
    
@@ -206,43 +172,12 @@ UpwindTotalFlux::UpdateDerivatives(const Teuchos::Ptr<State>& S,
 
   // Identify upwind/downwind cells for each local face.  Note upwind/downwind
   // may be a ghost cell.
-  Epetra_IntVector upwind_cell(mesh->face_map(true));
-  upwind_cell.PutValue(-1);
-  Epetra_IntVector downwind_cell(mesh->face_map(true));
-  downwind_cell.PutValue(-1);
-
-  AmanziMesh::Entity_ID_List faces;
-  std::vector<int> fdirs;
-
-  int ncells = dcell_v.MyLength();
-  for (int c=0; c!=ncells; ++c) {
-    mesh->cell_get_faces_and_dirs(c, &faces, &fdirs);
-
-    for (unsigned int n=0; n!=faces.size(); ++n) {
-      int f = faces[n];
-
-      if (f < nfaces_owned) {
-        if (flux_v[0][f] * fdirs[n] > 0) {
-          upwind_cell[f] = c;
-        } else if (flux_v[0][f] * fdirs[n] < 0) {
-          downwind_cell[f] = c;
-        } else {
-          // We don't care, but we have to get one into upwind and the other
-          // into downwind.
-          if (upwind_cell[f] == -1) {
-            upwind_cell[f] = c;
-          } else {
-            downwind_cell[f] = c;
-          }
-        }
-      }
-    }
-  }
+  upwind_cells_.Compute(*mesh, flux_v);
 
 
   for (unsigned int f=0; f!=nfaces_owned; ++f) {
-    int uw = upwind_cell[f];
-    int dw = downwind_cell[f];
+    int uw = upwind_cells_.upwind(f);
+    int dw = upwind_cells_.downwind(f);
     AMANZI_ASSERT(!((uw == -1) && (dw == -1)));
 
     AmanziMesh::Entity_ID_List cells;
@@ -14,6 +14,7 @@
 #define AMANZI_UPWINDING_TOTALFLUX_SCHEME_
 
 #include "upwinding.hh"
+#include "upwind_cell_map.hh"
 
 namespace Amanzi {
 
@@ -59,6 +60,7 @@ private:
   std::string cell_coef_;
   std::string face_coef_;
   std::string flux_;
+  mutable UpwindCellMap upwind_cells_;
   double flux_eps_;
 };
 
@@ -9,10 +9,18 @@
 
    CURRENT ASSUMPTIONS:
      1. parallel decomp not in the vertical
-     2. fields are not ordered along the column, and so must be copied
+     2. fields are not ordered along the column, and so are gathered into
+        column-major buffers once per step
      3. all columns have the same number of cells
    ------------------------------------------------------------------------- */
 
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "MeshPartition.hh"
 
 #include "bgc_simple_funcs.hh"
@@ -63,9 +71,12 @@ void BGCSimple::Setup(const Teuchos::Ptr<State>& S) {
 
   // initial timestep
   dt_ = plist_->get<double>("initial time step", 1.);
+  n_threads_ = plist_->get<int>("number of threads", 1);
+  veg_period_ = plist_->get<double>("vegetation update period [s]", 0.);
 
   // my mesh is the subsurface mesh, but we need the surface mesh, index by column, as well
   mesh_surf_ = S->GetMesh("surface");
+  columns_.Build(*mesh_);
 
   // Create the additional, non-managed data structures
   int nPools = plist_->get<int>("number of carbon pools", 7);
@@ -123,17 +134,18 @@ void BGCSimple::Setup(const Teuchos::Ptr<State>& S) {
     }
   }
 
-  // -- soil carbon pools
+  // -- soil carbon pools, which view the contiguous store som_
+  som_.resize(columns_.num_cells() * nPools);
   soil_carbon_pools_.resize(ncols);
   for (unsigned int col=0; col!=ncols; ++col) {
     soil_carbon_pools_[col].resize(ncells_per_col_);
 
-    auto& col_iter = mesh_->cells_of_column(col);
-    ncells_per_col_ = col_iter.size();
-        
-    for (std::size_t i=0; i!=col_iter.size(); ++i) {
-      // col_iter[i] = cell id, mp[cell_id] = index into partition list, sc_params_[index] = correct params
-      soil_carbon_pools_[col][i] = Teuchos::rcp(new SoilCarbon(sc_params_[mp[col_iter[i]]]));
+    const int* col_cells = columns_.cells(col);
+    int offset = columns_.offset(col);
+    for (int i=0; i!=columns_.num_cells(col); ++i) {
+      // col_cells[i] = cell id, mp[cell_id] = index into partition list, sc_params_[index] = correct params
+      soil_carbon_pools_[col][i] = Teuchos::rcp(new SoilCarbon(sc_params_[mp[col_cells[i]]],
+              &som_[(offset + i) * nPools]));
     }
   }
 
@@ -319,14 +331,36 @@ void BGCSimple::Initialize(const Teuchos::Ptr<State>& S) {
       *pfts_[col][i] = *pfts_old_[col][i];
     }
   }
+
+  veg_t_ = S->time();
+  veg_updated_ = false;
+  if (veg_period_ > 0.) {
+    met_int_.assign(ncols, MetData());
+    temp_int_.assign(columns_.num_cells(), 0.);
+    pres_int_.assign(columns_.num_cells(), 0.);
+  }
 }
 
   
 // -- Commit any secondary (dependent) variables.
 void BGCSimple::CommitStep(double told, double tnew, const Teuchos::RCP<State>& S) {
+  // Commit the forcing integrated since the last vegetation update, or
+  // restart the integrals if this step updated vegetation.
+  if (veg_period_ > 0.) {
+    if (veg_updated_) {
+      met_int_.assign(met_int_.size(), MetData());
+      std::fill(temp_int_.begin(), temp_int_.end(), 0.);
+      std::fill(pres_int_.begin(), pres_int_.end(), 0.);
+    } else {
+      std::swap(met_int_, met_int_next_);
+      std::swap(temp_int_, temp_int_next_);
+      std::swap(pres_int_, pres_int_next_);
+    }
+  }
+
   // Copy the PFT over, which includes all additional state required, commit
-  // the step as succesful.
-  double dt = tnew - told;
+  // the step as succesful.  PFTs only change on steps that update vegetation.
+  if (!veg_updated_) return;
 
   int ncols = mesh_surf_->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
   int npft = pfts_old_[0].size();
@@ -335,6 +369,8 @@ void BGCSimple::CommitStep(double told, double tnew, const Teuchos::RCP<State>&
       *pfts_old_[col][i] = *pfts_[col][i];
     }
   }
+  veg_t_ = tnew;
+  veg_updated_ = false;
 }
 
 // -- advance the model
@@ -349,16 +385,7 @@ bool BGCSimple::AdvanceStep(double t_old, double t_new, bool reinit) {
                << " t1 = " << S_next_->time() << " h = " << dt << std::endl
                << "----------------------------------------------------------------" << std::endl;
 
-  // Copy the PFT from old to new, in case we failed the previous attempt at
-  // this timestep.  This is hackery to get around the fact that PFTs are not
-  // (but should be) in state.
   AmanziMesh::Entity_ID ncols = mesh_surf_->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
-  for (AmanziMesh::Entity_ID col=0; col!=ncols; ++col) {
-    int npft = pfts_old_[col].size();
-    for (int i=0; i!=npft; ++i) {
-      *pfts_[col][i] = *pfts_old_[col][i];
-    }
-  }
 
   // grab the required fields
   Epetra_MultiVector& sc_pools = *S_next_->GetFieldData(key_, name_)
@@ -418,87 +445,161 @@ bool BGCSimple::AdvanceStep(double t_old, double t_new, bool reinit) {
   const Epetra_MultiVector& scv = *S_inter_->GetFieldData("surface-cell_volume")
       ->ViewComponent("cell", false);
 
-  // Create workspace arrays (these should be removed when data is correctly oriented).
-  Teuchos::RCP<Epetra_SerialDenseVector> temp_c =
-      Teuchos::rcp(new Epetra_SerialDenseVector(ncells_per_col_));
-  Teuchos::RCP<Epetra_SerialDenseVector> pres_c =
-      Teuchos::rcp(new Epetra_SerialDenseVector(ncells_per_col_));
-  Teuchos::RCP<Epetra_SerialDenseVector> dz_c =
-      Teuchos::rcp(new Epetra_SerialDenseVector(ncells_per_col_));
-  Teuchos::RCP<Epetra_SerialDenseVector> depth_c =
-      Teuchos::rcp(new Epetra_SerialDenseVector(ncells_per_col_));
-
-  // Create a workspace array for the result
-  Epetra_SerialDenseVector co2_decomp_c(ncells_per_col_);
-  Epetra_SerialDenseVector trans_c(ncells_per_col_);
-  double sw_c(0.);
+  // Gather the soil state into column-major workspace.  Geometry is gathered
+  // here, outside of the threaded loop, as the mesh caches it lazily.
+  int ncells = columns_.num_cells();
+  int nPools = sc_pools.NumVectors();
+  std::vector<double> temp_cm(ncells), pres_cm(ncells);
+  std::vector<double> depth_cm(ncells), dz_cm(ncells);
+  std::vector<double> co2_decomp_cm(ncells), trans_cm(ncells);
+  columns_.Gather(temp[0], temp_cm.data());
+  columns_.Gather(pres[0], pres_cm.data());
 
-  total_lai.PutScalar(0.);
-
-  // loop over columns and apply the model
   for (AmanziMesh::Entity_ID col=0; col!=ncols; ++col) {
-    // update the various soil arrays
-    FieldToColumn_(col, *temp(0), temp_c.ptr());
-    FieldToColumn_(col, *pres(0), pres_c.ptr());
-    ColDepthDz_(col, depth_c.ptr(), dz_c.ptr());
-
-    // copy over the soil carbon arrays
-    auto& col_iter = mesh_->cells_of_column(col);
-    ncells_per_col_ = col_iter.size();
-    
-    // -- serious cache thrash... --etc
-    for (std::size_t i=0; i!=col_iter.size(); ++i) {
-      AmanziGeometry::Point centroid = mesh_->cell_centroid(col_iter[i]);
-	  //      std::cout << "Col iter col=" << col << ", index i=" << i << ", cell=" << col_iter[i] << " at " << centroid << std::endl;
-      for (int p=0; p!=soil_carbon_pools_[col][i]->nPools; ++p) {
-        soil_carbon_pools_[col][i]->SOM[p] = sc_pools[p][col_iter[i]];
+    const int* col_cells = columns_.cells(col);
+    int offset = columns_.offset(col);
+    int n = columns_.num_cells(col);
+
+    Epetra_SerialDenseVector depth_c(View, &depth_cm[offset], n);
+    Epetra_SerialDenseVector dz_c(View, &dz_cm[offset], n);
+    ColDepthDz_(col, Teuchos::ptr(&depth_c), Teuchos::ptr(&dz_c));
+
+    // -- the soil carbon store is ordered as the columns
+    for (int i=0; i!=n; ++i) {
+      for (int p=0; p!=nPools; ++p) {
+        som_[(offset + i) * nPools + p] = sc_pools[p][col_cells[i]];
       }
     }
+  }
 
-    // Create the Met data struct
-    MetData met;
-    met.qSWin = qSWin[0][col];
-    met.tair = air_temp[0][col];
-    met.windv = wind_speed[0][col];
-    met.wind_ref_ht = wind_speed_ref_ht_;
-    met.relhum = rel_hum[0][col];
-    met.CO2a = co2[0][col];
-    met.lat = lat_;
-    sw_c = met.qSWin;
-
-    // call the model
-    BGCAdvance(S_inter_->time(), dt, scv[0][col], cryoturbation_coef_, met,
-               *temp_c, *pres_c, *depth_c, *dz_c,
-               pfts_[col], soil_carbon_pools_[col],
-               co2_decomp_c, trans_c, sw_c);
-
-    // copy back
-    // -- serious cache thrash... --etc
-    for (std::size_t i=0; i!=col_iter.size(); ++i) {
-      for (int p=0; p!=soil_carbon_pools_[col][i]->nPools; ++p) {
-        sc_pools[p][col_iter[i]] = soil_carbon_pools_[col][i]->SOM[p];
-      }
+  // Vegetation is updated every step, or, given an update period, on the
+  // first step ending in a new period, covering all time since the last
+  // update.  Soil carbon is updated every step.
+  bool restore_pfts = veg_updated_;  // a previous attempt at this step failed
+  veg_updated_ = veg_period_ <= 0. ||
+      std::floor(t_new / veg_period_) > std::floor(veg_t_ / veg_period_);
+  double dt_veg = t_new - veg_t_;
+  if (veg_updated_) total_lai.PutScalar(0.);
+
+  // Given an update period, vegetation is forced by the time averages, over
+  // all steps since its last update, of the same met data and soil state that
+  // an update every step would see.
+  std::vector<double> temp_veg_cm, pres_veg_cm;
+  if (veg_period_ > 0.) {
+    temp_veg_cm.resize(ncells);
+    pres_veg_cm.resize(ncells);
+    met_int_next_ = met_int_;
+    temp_int_next_ = temp_int_;
+    pres_int_next_ = pres_int_;
+    for (AmanziMesh::Entity_ID col=0; col!=ncols; ++col) {
+      MetData& met = met_int_next_[col];
+      met.qSWin += dt * qSWin[0][col];
+      met.tair += dt * air_temp[0][col];
+      met.windv += dt * wind_speed[0][col];
+      met.relhum += dt * rel_hum[0][col];
+      met.CO2a += dt * co2[0][col];
+    }
+    for (int i=0; i!=ncells; ++i) {
+      temp_int_next_[i] += dt * temp_cm[i];
+      pres_int_next_[i] += dt * pres_cm[i];
+      temp_veg_cm[i] = temp_int_next_[i] / dt_veg;
+      pres_veg_cm[i] = pres_int_next_[i] / dt_veg;
+    }
+  }
 
-      // and integrate the decomp
-      co2_decomp[0][col_iter[i]] += co2_decomp_c[i];
+  // loop over columns and apply the model -- columns are independent
+#ifdef _OPENMP
+  int n_threads = n_threads_ > 0 ? n_threads_ : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 16) num_threads(n_threads)
+#endif
+  for (AmanziMesh::Entity_ID col=0; col<ncols; ++col) {
+    // Copy the PFT from old to new, in case we failed the previous attempt at
+    // this timestep.  This is hackery to get around the fact that PFTs are not
+    // (but should be) in state.
+    int npft = pfts_old_[col].size();
+    if (restore_pfts) {
+      for (int i=0; i!=npft; ++i) {
+        *pfts_[col][i] = *pfts_old_[col][i];
+      }
+    }
 
+    // views of this column's workspace
+    int offset = columns_.offset(col);
+    int n = columns_.num_cells(col);
+    Epetra_SerialDenseVector temp_c(View, &temp_cm[offset], n);
+    Epetra_SerialDenseVector pres_c(View, &pres_cm[offset], n);
+    Epetra_SerialDenseVector depth_c(View, &depth_cm[offset], n);
+    Epetra_SerialDenseVector dz_c(View, &dz_cm[offset], n);
+    Epetra_SerialDenseVector co2_decomp_c(View, &co2_decomp_cm[offset], n);
+    Epetra_SerialDenseVector trans_c(View, &trans_cm[offset], n);
+
+    if (veg_updated_) {
+      // Create the Met data struct
+      MetData met;
+      if (veg_period_ > 0.) {
+        const MetData& met_int = met_int_next_[col];
+        met.qSWin = met_int.qSWin / dt_veg;
+        met.tair = met_int.tair / dt_veg;
+        met.windv = met_int.windv / dt_veg;
+        met.relhum = met_int.relhum / dt_veg;
+        met.CO2a = met_int.CO2a / dt_veg;
+      } else {
+        met.qSWin = qSWin[0][col];
+        met.tair = air_temp[0][col];
+        met.windv = wind_speed[0][col];
+        met.relhum = rel_hum[0][col];
+        met.CO2a = co2[0][col];
+      }
+      met.wind_ref_ht = wind_speed_ref_ht_;
+      met.lat = lat_;
+      double sw_c = met.qSWin;
+
+      // call the vegetation model
+      Epetra_SerialDenseVector temp_veg_c(View,
+              veg_period_ > 0. ? &temp_veg_cm[offset] : &temp_cm[offset], n);
+      Epetra_SerialDenseVector pres_veg_c(View,
+              veg_period_ > 0. ? &pres_veg_cm[offset] : &pres_cm[offset], n);
+      VegetationAdvance(veg_t_, dt_veg, scv[0][col], met,
+                        temp_veg_c, pres_veg_c, depth_c, dz_c,
+                        pfts_[col], soil_carbon_pools_[col],
+                        trans_c, sw_c);
 
-      // and pull in the transpiration, converting to mol/m^3/s, as a sink
-      trans[0][col_iter[i]] = trans_c[i] / .01801528;
       sw[0][col] = sw_c;
+      for (int lcv_pft=0; lcv_pft!=npft; ++lcv_pft) {
+        biomass[lcv_pft][col] = pfts_[col][lcv_pft]->totalBiomass;
+        leafbiomass[lcv_pft][col] = pfts_[col][lcv_pft]->Bleaf;
+        csink[lcv_pft][col] = pfts_[col][lcv_pft]->CSinkLimit;
+        lai[lcv_pft][col] = pfts_[col][lcv_pft]->lai;
+
+        total_transpiration[lcv_pft][col] = pfts_[col][lcv_pft]->ET / 0.01801528;
+        total_lai[0][col] += pfts_[col][lcv_pft]->lai;
+      }
     }
 
-    for (int lcv_pft=0; lcv_pft!=pfts_[col].size(); ++lcv_pft) {
-      biomass[lcv_pft][col] = pfts_[col][lcv_pft]->totalBiomass;
-      leafbiomass[lcv_pft][col] = pfts_[col][lcv_pft]->Bleaf;
-      csink[lcv_pft][col] = pfts_[col][lcv_pft]->CSinkLimit;
-      lai[lcv_pft][col] = pfts_[col][lcv_pft]->lai;
+    // call the soil carbon model
+    SoilCarbonAdvance(dt, cryoturbation_coef_,
+                      temp_c, pres_c, depth_c, dz_c,
+                      soil_carbon_pools_[col], co2_decomp_c);
+  } // end loop over columns
 
-      total_transpiration[lcv_pft][col] = pfts_[col][lcv_pft]->ET / 0.01801528;
-      total_lai[0][col] += pfts_[col][lcv_pft]->lai;
-    }
+  // scatter the soil results back
+  for (AmanziMesh::Entity_ID col=0; col!=ncols; ++col) {
+    const int* col_cells = columns_.cells(col);
+    int offset = columns_.offset(col);
+    for (int i=0; i!=columns_.num_cells(col); ++i) {
+      int c = col_cells[i];
+      for (int p=0; p!=nPools; ++p) {
+        sc_pools[p][c] = som_[(offset + i) * nPools + p];
+      }
 
-  } // end loop over columns
+      // and integrate the decomp
+      co2_decomp[0][c] += co2_decomp_cm[offset + i];
+
+      // and pull in the transpiration, converting to mol/m^3/s, as a sink.
+      // Between vegetation updates, the previous transpiration is held.
+      if (veg_updated_) trans[0][c] = trans_cm[offset + i] / .01801528;
+    }
+  }
 
   // mark primaries as changed
   trans_eval_->SetFieldAsChanged(S_next_.ptr());
@@ -515,18 +616,18 @@ void BGCSimple::FieldToColumn_(AmanziMesh::Entity_ID col, const Epetra_Vector& v
     col_vec = Teuchos::ptr(new Epetra_SerialDenseVector(ncells_per_col_));
   }
 
-  auto& col_iter = mesh_->cells_of_column(col);
-  for (std::size_t i=0; i!=col_iter.size(); ++i) {
-    (*col_vec)[i] = vec[col_iter[i]];
+  const int* col_cells = columns_.cells(col);
+  for (int i=0; i!=columns_.num_cells(col); ++i) {
+    (*col_vec)[i] = vec[col_cells[i]];
   }
 }
 
 // helper function for pushing field to column
 void BGCSimple::FieldToColumn_(AmanziMesh::Entity_ID col, const Epetra_Vector& vec,
                                double* col_vec, int ncol) {
-  auto& col_iter = mesh_->cells_of_column(col);
-  for (std::size_t i=0; i!=col_iter.size(); ++i) {
-    col_vec[i] = vec[col_iter[i]];
+  const int* col_cells = columns_.cells(col);
+  for (int i=0; i!=columns_.num_cells(col); ++i) {
+    col_vec[i] = vec[col_cells[i]];
   }
 }
 
@@ -535,49 +636,23 @@ void BGCSimple::FieldToColumn_(AmanziMesh::Entity_ID col, const Epetra_Vector& v
 void BGCSimple::ColDepthDz_(AmanziMesh::Entity_ID col,
                             Teuchos::Ptr<Epetra_SerialDenseVector> depth,
                             Teuchos::Ptr<Epetra_SerialDenseVector> dz) {
-  AmanziMesh::Entity_ID f_above = mesh_surf_->entity_get_parent(AmanziMesh::CELL, col);
-  auto& col_iter = mesh_->cells_of_column(col);
-  ncells_per_col_ = col_iter.size();
-  
-  AmanziGeometry::Point surf_centroid = mesh_->face_centroid(f_above);
-  AmanziGeometry::Point neg_z(3);
-  neg_z.set(0.,0.,-1);
+  // faces of the column, top to bottom, the first being the surface face
+  const int* col_cells = columns_.cells(col);
+  const int* col_faces = columns_.faces(col);
 
-  for (std::size_t i=0; i!=col_iter.size(); ++i) {
+  double surf_z = mesh_->face_centroid(col_faces[0])[2];
+  double z_above = surf_z;
+  for (int i=0; i!=columns_.num_cells(col); ++i) {
     // depth centroid
-    (*depth)[i] = surf_centroid[2] - mesh_->cell_centroid(col_iter[i])[2];
+    (*depth)[i] = surf_z - mesh_->cell_centroid(col_cells[i])[2];
 
     // dz
-    // -- find face_below
-    AmanziMesh::Entity_ID_List faces;
-    std::vector<int> dirs;
-    mesh_->cell_get_faces_and_dirs(col_iter[i], &faces, &dirs);
-
-    // -- mimics implementation of build_columns() in Mesh
-    double mindp = 999.0;
-    AmanziMesh::Entity_ID f_below = -1;
-    for (std::size_t j=0; j!=faces.size(); ++j) {
-      AmanziGeometry::Point normal = mesh_->face_normal(faces[j]);
-      if (dirs[j] == -1) normal *= -1;
-      normal /= AmanziGeometry::norm(normal);
-
-      double dp = -normal * neg_z;
-      if (dp < mindp) {
-        mindp = dp;
-        f_below = faces[j];
-      }
-    }
-
-    // -- fill the val
-    (*dz)[i] = mesh_->face_centroid(f_above)[2] - mesh_->face_centroid(f_below)[2];
+    double z_below = mesh_->face_centroid(col_faces[i+1])[2];
+    (*dz)[i] = z_above - z_below;
     AMANZI_ASSERT( (*dz)[i] > 0. );
-    f_above = f_below;
+    z_above = z_below;
   }
-
 }
 
-
-
-
 } // namespace
 } // namespace
@@ -49,6 +49,20 @@ that build_columns in the subsurface Mesh_ spec has been supplied.
 
   * `"cryoturbation mixing coefficient [cm^2/yr]`" ``[double]`` **5.0** Controls diffusion of carbon into the subsurface via cryoturbation.
 
+  * `"vegetation update period [s]`" ``[double]`` **0** If positive,
+    vegetation (phenology, photosynthesis, allocation and turnover) is
+    updated only on the first step ending in each new period of this length,
+    integrated over all time since its last update, and its transpiration
+    and shaded shortwave radiation are held between updates.  Over that
+    integration, vegetation sees the time-weighted averages of the met data
+    and soil temperature and pressure of every step since its last update.
+    Soil carbon decomposition is updated every step.  A period of 86400
+    matches daily met forcing.  If 0, vegetation is updated every step.
+
+  * `"number of threads`" ``[int]`` **1** Number of OpenMP threads across
+    which columns are advanced.  If 0, uses the OpenMP default.  Ignored if
+    ATS is not built with OpenMP.
+
   * `"leaf biomass initial condition`" ``[initial-conditions-spec]`` Sets the leaf biomass IC.
 
   * `"domain name`" ``[string]`` **domain**
@@ -79,6 +93,8 @@ that build_columns in the subsurface Mesh_ spec has been supplied.
 #ifndef PKS_BGC_SIMPLE_HH_
 #define PKS_BGC_SIMPLE_HH_
 
+#include <vector>
+
 #include "Teuchos_ParameterList.hpp"
 #include "Teuchos_RCP.hpp"
 #include "Epetra_SerialDenseVector.h"
@@ -88,10 +104,12 @@ that build_columns in the subsurface Mesh_ spec has been supplied.
 
 #include "PK_Factory.hh"
 #include "pk_physical_default.hh"
+#include "column_index.hh"
 
 #include "SoilCarbonParameters.hh"
 #include "PFT.hh"
 #include "SoilCarbon.hh"
+#include "utils.hh"
 
 namespace Amanzi {
 namespace BGC {
@@ -150,6 +168,7 @@ class BGCSimple : public PK_Physical_Default {
   double dt_;
   Teuchos::RCP<const AmanziMesh::Mesh> mesh_surf_;
   Key domain_surf_;
+  Operators::ColumnIndex columns_;
   
   // physical structs needed by model
   std::vector<Teuchos::RCP<SoilCarbonParameters> > sc_params_;
@@ -157,6 +176,10 @@ class BGCSimple : public PK_Physical_Default {
   std::vector<std::vector<Teuchos::RCP<PFT> > > pfts_old_;   // need two copies for failed timesteps
   std::vector<std::vector<Teuchos::RCP<SoilCarbon> > > soil_carbon_pools_;
 
+  // storage viewed by soil_carbon_pools_: the pools of each cell,
+  // contiguous, with cells ordered as in columns_
+  std::vector<double> som_;
+
   // evaluator for transpiration
   Teuchos::RCP<PrimaryVariableFieldEvaluator> trans_eval_;
   Teuchos::RCP<PrimaryVariableFieldEvaluator> sw_eval_;
@@ -167,6 +190,20 @@ class BGCSimple : public PK_Physical_Default {
   double wind_speed_ref_ht_;
   double cryoturbation_coef_;
   int ncells_per_col_;
+  int n_threads_;
+
+  // vegetation update cadence
+  double veg_period_;
+  double veg_t_;       // time of the last committed vegetation update
+  bool veg_updated_;   // vegetation was updated in the current step
+
+  // time integrals of the vegetation forcing since its last update, through
+  // the last committed step and through the current step: met data by
+  // column, and soil temperature and pressure ordered as in columns_
+  std::vector<MetData> met_int_, met_int_next_;
+  std::vector<double> temp_int_, temp_int_next_;
+  std::vector<double> pres_int_, pres_int_next_;
+
   std::string soil_part_name_;
 
   // keys
@@ -46,6 +46,27 @@ namespace BGC {
 		  Epetra_SerialDenseVector& SoilCO2Arr,
 		  Epetra_SerialDenseVector& TransArr,
 		  double& sw_shaded)
+  {
+    VegetationAdvance(t, dt, gridarea, met, SoilTArr, SoilWPArr, SoilDArr, SoilThicknessArr,
+                      pftarr, soilcarr, TransArr, sw_shaded);
+    SoilCarbonAdvance(dt, cryoturbation_coef, SoilTArr, SoilWPArr, SoilDArr, SoilThicknessArr,
+                      soilcarr, SoilCO2Arr);
+  }
+
+
+  // Vegetation: phenology, photosynthesis, allocation, mortality and
+  // turnover of each PFT, litter inputs to the soil carbon pools, and
+  // transpiration and shaded shortwave radiation.
+  void VegetationAdvance(double t, double dt, double gridarea,
+                         const MetData& met,
+                         const Epetra_SerialDenseVector& SoilTArr,
+                         const Epetra_SerialDenseVector& SoilWPArr,
+                         const Epetra_SerialDenseVector& SoilDArr,
+                         const Epetra_SerialDenseVector& SoilThicknessArr,
+                         std::vector<Teuchos::RCP<PFT> >& pftarr,
+                         std::vector<Teuchos::RCP<SoilCarbon> >& soilcarr,
+                         Epetra_SerialDenseVector& TransArr,
+                         double& sw_shaded)
   {
   // required constants
   double p_atm = 101325.;
@@ -687,8 +708,24 @@ namespace BGC {
     radi *= std::exp(-(*pft_iter)->LER * (*pft_iter)->lai);
    }
   sw_shaded = radi;
+  }
+
 
-      
+  // Soil carbon: decomposition and cryoturbation.
+  void SoilCarbonAdvance(double dt, double cryoturbation_coef,
+                         const Epetra_SerialDenseVector& SoilTArr,
+                         const Epetra_SerialDenseVector& SoilWPArr,
+                         const Epetra_SerialDenseVector& SoilDArr,
+                         const Epetra_SerialDenseVector& SoilThicknessArr,
+                         std::vector<Teuchos::RCP<SoilCarbon> >& soilcarr,
+                         Epetra_SerialDenseVector& SoilCO2Arr)
+  {
+  // required constants
+  double p_atm = 101325.;
+  double dt_days = dt / 86400.;
+  double wp_max = -1.e-6; //MPa wp = p - p_atm
+  double wp_min = -10.; //MPa
+  int ncells = SoilTArr.Length();
 
  //=========================================================================
   // do soil decomposition
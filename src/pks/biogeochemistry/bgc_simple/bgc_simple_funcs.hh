@@ -35,6 +35,28 @@ void BGCAdvance(double t, double dt, double gridarea, double cryoturbation_coef,
              Epetra_SerialDenseVector& TransArr,
              double& sw_shaded);
 
+// BGCAdvance is VegetationAdvance followed by SoilCarbonAdvance over the
+// same step.  They may also be called separately, with vegetation on a
+// longer step than soil carbon.
+void VegetationAdvance(double t, double dt, double gridarea,
+                       const MetData& met,
+                       const Epetra_SerialDenseVector& SoilTArr,
+                       const Epetra_SerialDenseVector& SoilArr,
+                       const Epetra_SerialDenseVector& SoilDArr,
+                       const Epetra_SerialDenseVector& SoilThicknessArr,
+                       std::vector<Teuchos::RCP<PFT> >& pftarr,
+                       std::vector<Teuchos::RCP<SoilCarbon> >& soilcarr,
+                       Epetra_SerialDenseVector& TransArr,
+                       double& sw_shaded);
+
+void SoilCarbonAdvance(double dt, double cryoturbation_coef,
+                       const Epetra_SerialDenseVector& SoilTArr,
+                       const Epetra_SerialDenseVector& SoilArr,
+                       const Epetra_SerialDenseVector& SoilDArr,
+                       const Epetra_SerialDenseVector& SoilThicknessArr,
+                       std::vector<Teuchos::RCP<SoilCarbon> >& soilcarr,
+                       Epetra_SerialDenseVector& SoilCO2Arr);
+
 void Cryoturbate(double dt,
 		 const Epetra_SerialDenseVector& SoilTArr,
 		 const Epetra_SerialDenseVector& SoilDArr,
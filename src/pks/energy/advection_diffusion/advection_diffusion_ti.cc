@@ -82,6 +82,8 @@ int AdvectionDiffusion::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Te
 
 // updates the preconditioner
 void AdvectionDiffusion::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   AMANZI_ASSERT(std::abs(S_next_->time() - t) <= 1.e-4*t);
   PK_PhysicalBDF_Default::Solution_to_State(*up, S_next_);
 
@@ -185,8 +185,8 @@ public:
   virtual void CalculateDiagnostics(const Teuchos::RCP<State>& S) override {}
 
   // Default implementations of BDFFnBase methods.
-  // -- Compute a norm on u-du and return the result.
-  virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
+  // -- Compute this rank's contribution to a norm on u-du.
+  virtual double ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
                        Teuchos::RCP<const TreeVector> du) override;
 
   // EnergyBase is a BDFFnBase
@@ -174,9 +174,10 @@ void EnergyBase::ApplyDirichletBCsToEnthalpy_(const Teuchos::Ptr<State>& S) {
   if (T_vec.HasComponent("boundary_face")) {
     Epetra_MultiVector& T_bf = *T_vec.ViewComponent("boundary_face", false);
     const Epetra_MultiVector& T_c = *T_vec.ViewComponent("cell", false);
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh_);
 
     for (int bf=0; bf!=T_bf.MyLength(); ++bf) {
-      AmanziMesh::Entity_ID f = getBoundaryFaceFace(*mesh_, bf);
+      AmanziMesh::Entity_ID f = bfs.face(bf);
 
       // NOTE: this should get refactored into a helper class, much like predictor_delegate_bc_flux
       // as this would be necessary to deal with general discretizations.  Note that this is not
@@ -184,7 +185,7 @@ void EnergyBase::ApplyDirichletBCsToEnthalpy_(const Teuchos::Ptr<State>& S) {
       if (bc_markers()[f] == Operators::OPERATOR_BC_NEUMANN &&
           bc_adv_->bc_model()[f] == Operators::OPERATOR_BC_DIRICHLET) {
         // diffusive flux BC
-        AmanziMesh::Entity_ID c = getFaceOnBoundaryInternalCell(*mesh_, f);
+        AmanziMesh::Entity_ID c = bfs.cell(bf);
         const auto& Acc = matrix_diff_->local_op()->matrices_shadow[f];
         T_bf[0][bf] = (Acc(0,0)*T_c[0][c] - bc_values()[f]*mesh_->face_area(f)) / Acc(0,0);
       }
@@ -197,9 +198,10 @@ void EnergyBase::ApplyDirichletBCsToEnthalpy_(const Teuchos::Ptr<State>& S) {
   const Epetra_MultiVector& enth_bf =
     *S->GetFieldData(enthalpy_key_)->ViewComponent("boundary_face",false);
 
+  const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh_);
   int nbfaces = enth_bf.MyLength();
   for (int bf=0; bf!=nbfaces; ++bf) {
-    AmanziMesh::Entity_ID f = getBoundaryFaceFace(*mesh_, bf);
+    AmanziMesh::Entity_ID f = bfs.face(bf);
 
     if (bc_adv_->bc_model()[f] == Operators::OPERATOR_BC_DIRICHLET) {
       bc_adv_->bc_value()[f] = enth_bf[0][bf];
@@ -799,9 +799,10 @@ EnergyBase::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
 
     const Epetra_MultiVector& dT_c = *du->Data()->ViewComponent("cell", false);
     Epetra_MultiVector& dT_bf = *du->Data()->ViewComponent("boundary_face", false);
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh_);
 
     for (int bf=0; bf!=T_bf.MyLength(); ++bf) {
-      AmanziMesh::Entity_ID f = getBoundaryFaceFace(*mesh_, bf);
+      AmanziMesh::Entity_ID f = bfs.face(bf);
 
       // NOTE: this should get refactored into a helper class, much like predictor_delegate_bc_flux
       // as this would be necessary to deal with general discretizations.  Note that this is not
@@ -809,7 +810,7 @@ EnergyBase::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
       if (bc_markers()[f] == Operators::OPERATOR_BC_NEUMANN &&
           bc_adv_->bc_model()[f] == Operators::OPERATOR_BC_DIRICHLET) {
         // diffusive flux BC
-        AmanziMesh::Entity_ID c = getFaceOnBoundaryInternalCell(*mesh_, f);
+        AmanziMesh::Entity_ID c = bfs.cell(bf);
         const auto& Acc = matrix_diff_->local_op()->matrices_shadow[f];
         double T_bf_val = (Acc(0,0)*(T_c[0][c] - dT_c[0][c]) - bc_values()[f]*mesh_->face_area(f)) / Acc(0,0);
         dT_bf[0][bf] = T_bf[0][bf] - T_bf_val;
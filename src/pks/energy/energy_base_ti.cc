@@ -15,6 +15,7 @@ Author: Ethan Coon
 #include "FieldEvaluator.hh"
 #include "energy_base.hh"
 #include "Op.hh"
+#include "pk_helpers.hh"
 
 namespace Amanzi {
 namespace Energy {
@@ -38,6 +39,10 @@ void EnergyBase::FunctionalResidual(double t_old, double t_new, Teuchos::RCP<Tre
   Solution_to_State(*u_new, S_next_);
   Teuchos::RCP<CompositeVector> u = u_new->Data();
 
+  // debugger output is only gathered if it will be written
+  bool debug = isDebuggerActive(*db_, *mesh_, db_verbosity_);
+  Teuchos::RCP<Teuchos::TimeMonitor> monitor = MonitorResidual_();
+
 #if DEBUG_FLAG
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "----------------------------------------------------------------" << std::endl
@@ -45,12 +50,14 @@ void EnergyBase::FunctionalResidual(double t_old, double t_new, Teuchos::RCP<Tre
                << " t1 = " << t_new << " h = " << h << std::endl;
 
   // dump u_old, u_new
-  db_->WriteCellInfo(true);
-  std::vector<std::string> vnames;
-  vnames.push_back("T_old"); vnames.push_back("T_new");
-  std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
-  vecs.push_back(S_inter_->GetFieldData(key_).ptr()); vecs.push_back(u.ptr());
-  db_->WriteVectors(vnames, vecs, true);
+  if (debug) {
+    db_->WriteCellInfo(true);
+    std::vector<std::string> vnames;
+    vnames.push_back("T_old"); vnames.push_back("T_new");
+    std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
+    vecs.push_back(S_inter_->GetFieldData(key_).ptr()); vecs.push_back(u.ptr());
+    db_->WriteVectors(vnames, vecs, true);
+  }
 
   // vnames[0] = "sl"; vnames[1] = "si";
   // vecs[0] = S_next_->GetFieldData("saturation_liquid").ptr();
@@ -63,7 +70,7 @@ void EnergyBase::FunctionalResidual(double t_old, double t_new, Teuchos::RCP<Tre
   bc_diff_flux_->Compute(t_new);
   bc_flux_->Compute(t_new);
   UpdateBoundaryConditions_(S_next_.ptr());
-  db_->WriteBoundaryConditions(bc_markers(), bc_values());
+  if (debug) db_->WriteBoundaryConditions(bc_markers(), bc_values());
 
   // zero out residual
   Teuchos::RCP<CompositeVector> res = g->Data();
@@ -72,19 +79,24 @@ void EnergyBase::FunctionalResidual(double t_old, double t_new, Teuchos::RCP<Tre
   // diffusion term, implicit
   ApplyDiffusion_(S_next_.ptr(), res.ptr());
 #if DEBUG_FLAG
-  db_->WriteVector("K",S_next_->GetFieldData(conductivity_key_).ptr(),true);
-  db_->WriteVector("res (diff)", res.ptr(), true);
+  if (debug) {
+    db_->WriteVector("K",S_next_->GetFieldData(conductivity_key_).ptr(),true);
+    db_->WriteVector("res (diff)", res.ptr(), true);
+  }
 #endif
 
   // accumulation term
   AddAccumulation_(res.ptr());
 #if DEBUG_FLAG
-  vnames[0] = "e_old";
-  vnames[1] = "e_new";
-  vecs[0] = S_inter_->GetFieldData(conserved_key_).ptr();
-  vecs[1] = S_next_->GetFieldData(conserved_key_).ptr();
-  db_->WriteVectors(vnames, vecs, true);
-  db_->WriteVector("res (acc)", res.ptr());
+  if (debug) {
+    std::vector<std::string> vnames;
+    vnames.push_back("e_old"); vnames.push_back("e_new");
+    std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
+    vecs.push_back(S_inter_->GetFieldData(conserved_key_).ptr());
+    vecs.push_back(S_next_->GetFieldData(conserved_key_).ptr());
+    db_->WriteVectors(vnames, vecs, true);
+    db_->WriteVector("res (acc)", res.ptr());
+  }
 #endif
 
   // advection term
@@ -95,14 +107,14 @@ void EnergyBase::FunctionalResidual(double t_old, double t_new, Teuchos::RCP<Tre
       AddAdvection_(S_inter_.ptr(), res.ptr(), true);
     }
 #if DEBUG_FLAG
-  db_->WriteVector("res (adv)", res.ptr(), true);
+  if (debug) db_->WriteVector("res (adv)", res.ptr(), true);
 #endif
   }
 
   // source terms
   AddSources_(S_next_.ptr(), res.ptr());
 #if DEBUG_FLAG
-  db_->WriteVector("res (src)", res.ptr());
+  if (debug) db_->WriteVector("res (src)", res.ptr());
 #endif
 
   // Dump residual to state for visual debugging.
@@ -127,17 +139,18 @@ void EnergyBase::FunctionalResidual(double t_old, double t_new, Teuchos::RCP<Tre
 // -----------------------------------------------------------------------------
 int EnergyBase::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> Pu) {
 #if DEBUG_FLAG
+  bool debug = isDebuggerActive(*db_, *mesh_, db_verbosity_);
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "Precon application:" << std::endl;
-  db_->WriteVector("T_res", u->Data().ptr(), true);
+  if (debug) db_->WriteVector("T_res", u->Data().ptr(), true);
 #endif
 
   // apply the preconditioner
   int ierr = preconditioner_->ApplyInverse(*u->Data(), *Pu->Data());
 
 #if DEBUG_FLAG
-  db_->WriteVector("PC*T_res", Pu->Data().ptr(), true);
+  if (debug) db_->WriteVector("PC*T_res", Pu->Data().ptr(), true);
 #endif
 
   return (ierr > 0) ? 0 : 1;
@@ -148,6 +161,8 @@ int EnergyBase::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::R
 // Update the preconditioner at time t and u = up
 // -----------------------------------------------------------------------------
 void EnergyBase::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   // VerboseObject stuff.
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_HIGH))
@@ -274,9 +289,10 @@ void EnergyBase::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> u
 };
 
 // -----------------------------------------------------------------------------
-// Default enorm that uses an abs and rel tolerance to monitor convergence.
+// This rank's contribution to the enorm, which uses an abs and rel tolerance
+// to monitor convergence.
 // -----------------------------------------------------------------------------
-double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
+double EnergyBase::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
         Teuchos::RCP<const TreeVector> res) {
   // Abs tol based on old conserved quantity -- we know these have been vetted
   // at some level whereas the new quantity is some iterate, and may be
@@ -302,11 +318,6 @@ double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
   Teuchos::RCP<const CompositeVector> dvec = res->Data();
   double h = S_next_->time() - S_inter_->time();
 
-  Teuchos::RCP<const Comm_type> comm_p = mesh_->get_comm();
-  Teuchos::RCP<const MpiComm_type> mpi_comm_p =
-    Teuchos::rcp_dynamic_cast<const MpiComm_type>(comm_p);
-  const MPI_Comm& comm = mpi_comm_p->Comm();
-
   double enorm_val = 0.0;
   for (CompositeVector::name_iterator comp=dvec->begin();
        comp!=dvec->end(); ++comp) {
@@ -332,15 +343,14 @@ double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 
     } else if (*comp == std::string("face")) {
       // error in flux -- relative to cell's extensive conserved quantity
+      UpdateErrorNormFaceCells_();
       int nfaces = dvec->size(*comp, false);
 
       for (unsigned int f=0; f!=nfaces; ++f) {
-        AmanziMesh::Entity_ID_List cells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
-        double cv_min = cells.size() == 1 ? cv[0][cells[0]]
-            : std::min(cv[0][cells[0]],cv[0][cells[1]]);
-        double mass_min = cells.size() == 1 ? wc[0][cells[0]]/cv[0][cells[0]]
-          : std::min(wc[0][cells[0]]/cv[0][cells[0]], wc[0][cells[1]]/cv[0][cells[1]]);
+        AmanziMesh::Entity_ID c0 = enorm_face_cells_[2*f];
+        AmanziMesh::Entity_ID c1 = enorm_face_cells_[2*f+1];
+        double cv_min = std::min(cv[0][c0], cv[0][c1]);
+        double mass_min = std::min(wc[0][c0]/cv[0][c0], wc[0][c1]/cv[0][c1]);
         mass_min = std::max(mass_min, mass_atol_);
 
         double energy = mass_min * atol_ + soil_atol_;
@@ -363,6 +373,11 @@ double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 
     // Write out Inf norms too.
     if (vo_->os_OK(Teuchos::VERB_MEDIUM)) {
+      Teuchos::RCP<const Comm_type> comm_p = mesh_->get_comm();
+      Teuchos::RCP<const MpiComm_type> mpi_comm_p =
+        Teuchos::rcp_dynamic_cast<const MpiComm_type>(comm_p);
+      const MPI_Comm& comm = mpi_comm_p->Comm();
+
       double infnorm(0.);
       dvec_v.NormInf(&infnorm);
 
@@ -379,12 +394,6 @@ double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 
     enorm_val = std::max(enorm_val, enorm_comp);
   }
-
-  double enorm_val_l = enorm_val;
-
-  int ierr;
-  ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, comm);
-  AMANZI_ASSERT(!ierr);
   return enorm_val;
 };
 
@@ -62,6 +62,8 @@ InterfrostEnergy::AddAccumulation_(const Teuchos::Ptr<CompositeVector>& g) {
 
 void
 InterfrostEnergy::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   // VerboseObject stuff.
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_HIGH))
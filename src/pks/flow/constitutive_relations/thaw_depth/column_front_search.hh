@@ -0,0 +1,39 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Local search for a front in a column, starting from a previous location.
+
+  Fronts such as the freezing front or the water table move by only a few
+  cells per step, so rather than rescanning the whole column each
+  evaluation, the search starts at the previous front and moves outward,
+  one cell up and one cell down at a time, until a front is found.
+*/
+
+#ifndef AMANZI_FLOWRELATIONS_COLUMN_FRONT_SEARCH_
+#define AMANZI_FLOWRELATIONS_COLUMN_FRONT_SEARCH_
+
+#include <algorithm>
+
+namespace Amanzi {
+namespace Flow {
+
+// Returns the k in [0, n] nearest to guess for which is_front(k) holds, or
+// -1 if it holds nowhere.  Ties are broken toward the surface.  A guess
+// outside of [0, n] searches from the top.
+template<typename IsFront>
+int
+SearchColumnFront(int guess, int n, const IsFront& is_front)
+{
+  if (guess < 0 || guess > n) guess = 0;
+  int span = std::max(guess, n - guess);
+  for (int d=0; d<=span; ++d) {
+    if (guess - d >= 0 && is_front(guess - d)) return guess - d;
+    if (d > 0 && guess + d <= n && is_front(guess + d)) return guess + d;
+  }
+  return -1;
+}
+
+} //namespace
+} //namespace
+
+#endif
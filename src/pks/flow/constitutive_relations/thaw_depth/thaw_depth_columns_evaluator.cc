@@ -7,6 +7,7 @@
   Authors: Ahmad Jan (jana@ornl.gov)
 */
 
+#include "column_front_search.hh"
 #include "thaw_depth_columns_evaluator.hh"
 
 namespace Amanzi {
@@ -15,7 +16,9 @@ namespace Flow {
 
 
 ThawDepthColumnsEvaluator::ThawDepthColumnsEvaluator(Teuchos::ParameterList& plist)
-    : SecondaryVariableFieldEvaluator(plist)
+    : SecondaryVariableFieldEvaluator(plist),
+      updated_once_(false),
+      front_(-1)
 {
   Key dset_name = plist.get<std::string>("domain set name", "column");
   
@@ -28,12 +31,20 @@ ThawDepthColumnsEvaluator::ThawDepthColumnsEvaluator(Teuchos::ParameterList& pli
   dependencies_.insert(temp_key_);
 
   trans_width_ =  plist_.get<double>("transition width [K]", 0.2);
+  incremental_ = plist_.get<bool>("incremental front search", false);
+  interpolate_ = plist_.get<bool>("interpolate thaw front", false);
 }
   
 
 ThawDepthColumnsEvaluator::ThawDepthColumnsEvaluator(const ThawDepthColumnsEvaluator& other)
   : SecondaryVariableFieldEvaluator(other),
-    temp_key_(other.temp_key_)
+    updated_once_(other.updated_once_),
+    trans_width_(other.trans_width_),
+    domain_(other.domain_),
+    temp_key_(other.temp_key_),
+    incremental_(other.incremental_),
+    interpolate_(other.interpolate_),
+    front_(other.front_)
 {}
   
 Teuchos::RCP<FieldEvaluator>
@@ -52,23 +63,41 @@ ThawDepthColumnsEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
   double trans_temp = 273.15 + 0.5*trans_width_;
 
   // search through the column and find the deepest unfrozen cell
-
   std::string domain_ss = Keys::getDomain(temp_key_);
-  const auto& top_z_centroid = S->GetMesh(domain_ss)->face_centroid(0);
-  AmanziGeometry::Point z_centroid(top_z_centroid);
+  const AmanziMesh::Mesh& mesh = *S->GetMesh(domain_ss);
 
   const auto& temp_c = *S->GetFieldData(temp_key_)
     ->ViewComponent("cell", false);
-    
   int col_cells = temp_c.MyLength();
-  for (int i=0; i!=col_cells; ++i) {
-    if (temp_c[0][i] >= trans_temp) {
-      z_centroid = S->GetMesh(domain_ss)->face_centroid(i+1);
+
+  // the front is the face below the deepest unfrozen cell, or the top face if
+  // there is none
+  int front = 0;
+  if (incremental_) {
+    auto is_front = [&](int k) {
+      return (k == 0 || temp_c[0][k-1] >= trans_temp)
+          && (k == col_cells || temp_c[0][k] < trans_temp);
+    };
+    front = std::max(SearchColumnFront(front_, col_cells, is_front), 0);
+  } else {
+    for (int i=0; i!=col_cells; ++i) {
+      if (temp_c[0][i] >= trans_temp) front = i+1;
     }
   }
-  
-  res_c[0][0] = top_z_centroid[2] - z_centroid[2];
-  
+  front_ = front;
+
+  double z_front = mesh.face_centroid(front)[2];
+  if (interpolate_ && front > 0 && front < col_cells) {
+    // the cell above is thawed and the cell below frozen, so the
+    // temperature crosses trans_temp between their centroids
+    double T_above = temp_c[0][front-1];
+    double T_below = temp_c[0][front];
+    double z_above = mesh.cell_centroid(front-1)[2];
+    double z_below = mesh.cell_centroid(front)[2];
+    z_front = z_above + (T_above - trans_temp) / (T_above - T_below) * (z_below - z_above);
+  }
+
+  res_c[0][0] = mesh.face_centroid(0)[2] - z_front;
 }
   
 void
@@ -5,6 +5,20 @@
   This computes the thaw depth over time.
   This is SecondaryVariablesFieldEvaluator and depends on the subsurface temperature, 
 
+  Options:
+    * "transition width [K]" [double] 0.2  Cells warmer than 273.15 plus half
+      this width are thawed.
+    * "incremental front search" [bool] false  If true, the thaw front is
+      searched for outward from its location at the previous evaluation,
+      rather than by scanning the full column.  This finds the front nearest
+      the previous one, which differs from the full scan (the bottom of the
+      deepest thawed cell) only when the column has more than one thawed
+      layer, e.g. a talik below a refrozen layer.
+    * "interpolate thaw front" [bool] false  If true, the front is placed
+      where the temperature, interpolated linearly between the centroids of
+      the last thawed and first frozen cells, crosses the transition
+      temperature, rather than at the face between them.
+
   Authors: Ahmad Jan (jana@ornl.gov)
 */
 
@@ -42,6 +56,10 @@ protected:
   double trans_width_;
   Key domain_;
   Key temp_key_;
+
+  bool incremental_;
+  bool interpolate_;
+  int front_;  // face index of the front at the previous evaluation, or -1
 private:
   static Utils::RegisteredFactory<FieldEvaluator,ThawDepthColumnsEvaluator> reg_;
 
@@ -39,19 +39,20 @@ ThawDepthEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
   double trans_temp = 273.15 + 0.5*trans_width_;
 
+  columns_.Build(*subsurf_mesh);
+  crossing_.resize(res_c.MyLength());
+  columns_.FirstCrossing(temp_c[0], [=](double T) { return T < trans_temp; },
+                         crossing_.data());
+
   for (AmanziMesh::Entity_ID sc=0; sc!=res_c.MyLength(); ++sc) {
     AmanziMesh::Entity_ID top_f = surf_mesh->entity_get_parent(AmanziMesh::CELL, sc);
     double top_z = subsurf_mesh->face_centroid(top_f)[z_dim];
 
+    // the thaw depth is at the face above the first frozen cell
     double thaw_z = std::numeric_limits<double>::quiet_NaN();
-    for (int i=0; i!=subsurf_mesh->cells_of_column(sc).size(); ++i) {
-      AmanziMesh::Entity_ID c = subsurf_mesh->cells_of_column(sc)[i];
-      if (temp_c[0][c] < trans_temp) {
-        // find the face above
-        AmanziMesh::Entity_ID f_up = subsurf_mesh->faces_of_column(sc)[i];
-        thaw_z = subsurf_mesh->face_centroid(f_up)[z_dim];
-        break;
-      }
+    if (crossing_[sc] >= 0) {
+      AmanziMesh::Entity_ID f_up = columns_.faces(sc)[crossing_[sc]];
+      thaw_z = subsurf_mesh->face_centroid(f_up)[z_dim];
     }
     res_c[0][sc] = top_z - thaw_z;
   }
@@ -27,8 +27,11 @@ Evaluator name: `"thaw depth`"
 
 #pragma once
 
+#include <vector>
+
 #include "Factory.hh"
 #include "secondary_variable_field_evaluator.hh"
+#include "column_index.hh"
 
 namespace Amanzi {
 namespace Flow {
@@ -61,6 +64,11 @@ class ThawDepthEvaluator : public SecondaryVariableFieldEvaluator {
   Key domain_, domain_ss_;
   Key temp_key_;
 
+  // column-major index of the subsurface mesh, and the crossing cell of
+  // each column
+  Operators::ColumnIndex columns_;
+  std::vector<int> crossing_;
+
  private:
   static Utils::RegisteredFactory<FieldEvaluator,ThawDepthEvaluator> reg_;
 
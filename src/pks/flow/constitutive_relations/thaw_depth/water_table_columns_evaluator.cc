@@ -7,13 +7,16 @@
   Authors: Ahmad Jan (jana@ornl.gov)
 */
 
+#include "column_front_search.hh"
 #include "water_table_columns_evaluator.hh"
 
 namespace Amanzi {
 namespace Flow {
 
 WaterTableColumnsEvaluator::WaterTableColumnsEvaluator(Teuchos::ParameterList& plist)
-    : SecondaryVariableFieldEvaluator(plist)
+    : SecondaryVariableFieldEvaluator(plist),
+      updated_once_(false),
+      front_(-1)
 {
   Key dset_name = plist.get<std::string>("domain set name", "column");
   Key surf_dset_name = plist.get<std::string>("surface domain set name", "surface_column");
@@ -34,14 +37,20 @@ WaterTableColumnsEvaluator::WaterTableColumnsEvaluator(Teuchos::ParameterList& p
   dependencies_.insert(pd_key_);
   
   trans_width_ =  plist_.get<double>("transition width [K]", 0.0);
+  incremental_ = plist_.get<bool>("incremental front search", false);
 }
   
 
 WaterTableColumnsEvaluator::WaterTableColumnsEvaluator(const WaterTableColumnsEvaluator& other)
   : SecondaryVariableFieldEvaluator(other),
+    updated_once_(other.updated_once_),
     temp_key_(other.temp_key_),
     sat_key_(other.sat_key_),
-    pd_key_(other.pd_key_)
+    pd_key_(other.pd_key_),
+    domain_(other.domain_),
+    trans_width_(other.trans_width_),
+    incremental_(other.incremental_),
+    front_(other.front_)
 {}
   
 Teuchos::RCP<FieldEvaluator>
@@ -57,34 +66,39 @@ WaterTableColumnsEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 { 
   Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
   
-  double trans_temp = 273.15 + 0.5*trans_width_;
-
-  // search through the column and find the deepest unfrozen cell
-
+  // search through the column and find the shallowest saturated cell
   std::string domain_ss = Keys::getDomain(temp_key_);
-  const auto& top_z_centroid = S->GetMesh(domain_ss)->face_centroid(0);
-  AmanziGeometry::Point z_centroid(top_z_centroid);
+  const AmanziMesh::Mesh& mesh = *S->GetMesh(domain_ss);
 
-  const auto& temp_c = *S->GetFieldData(temp_key_)->ViewComponent("cell", false);
   const auto& sat_c = *S->GetFieldData(sat_key_)->ViewComponent("cell", false);
   const auto& pd_c = *S->GetFieldData(pd_key_)->ViewComponent("cell", false);
   
-  int col_cells = temp_c.MyLength();
-  bool water_flag = false;
+  int col_cells = sat_c.MyLength();
 
   if (pd_c[0][0] >0) {
-    res_c[0][0] = top_z_centroid[2] + pd_c[0][0];
+    res_c[0][0] = mesh.face_centroid(0)[2] + pd_c[0][0];
   }
   else {
-    for (int i=0; i!=col_cells; ++i) {
-      if (sat_c[0][i] == 1.0) {
-        z_centroid = S->GetMesh(domain_ss)->face_centroid(i+1);
-        water_flag = true;
-        break;
+    int wt = -1;
+    if (incremental_) {
+      auto is_front = [&](int i) {
+        return i < col_cells && sat_c[0][i] == 1.0
+            && (i == 0 || sat_c[0][i-1] != 1.0);
+      };
+      wt = SearchColumnFront(front_, col_cells, is_front);
+    } else {
+      for (int i=0; i!=col_cells; ++i) {
+        if (sat_c[0][i] == 1.0) {
+          wt = i;
+          break;
+        }
       }
     }
-    if (water_flag)
-      res_c[0][0] = z_centroid[2];
+
+    if (wt >= 0) {
+      res_c[0][0] = mesh.face_centroid(wt+1)[2];
+      front_ = wt;
+    }
     else
       res_c[0][0] = res_c[0][0]; // water table location unchanged (frozen)
   }
@@ -5,6 +5,14 @@
   This computes the thaw depth over time.
   This is SecondaryVariablesFieldEvaluator and depends on the subsurface temperature, 
 
+  Options:
+    * "incremental front search" [bool] false  If true, the water table is
+      searched for outward from its location at the previous evaluation,
+      rather than by scanning the column from the top.  This finds the top of
+      the saturated zone nearest the previous one, which differs from the
+      full scan (the shallowest saturated cell) only when the column has
+      more than one saturated zone, e.g. a perched water table.
+
   Authors: Ahmad Jan (jana@ornl.gov)
 */
 
@@ -42,6 +50,9 @@ protected:
   Key temp_key_, sat_key_, pd_key_;
   Key domain_;
   double trans_width_;
+
+  bool incremental_;
+  int front_;  // index of the water table cell at the previous evaluation, or -1
 private:
   static Utils::RegisteredFactory<FieldEvaluator,WaterTableColumnsEvaluator> reg_;
 
@@ -41,19 +41,20 @@ WaterTableDepthEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
   const auto& subsurf_mesh = S->GetMesh(domain_ss_);
   int z_dim = subsurf_mesh->space_dimension() - 1;
 
+  columns_.Build(*subsurf_mesh);
+  crossing_.resize(res_c.MyLength());
+  columns_.FirstCrossing(sat_c[0], [](double sg) { return sg == 0.; },
+                         crossing_.data());
+
   for (AmanziMesh::Entity_ID sc=0; sc!=res_c.MyLength(); ++sc) {
     AmanziMesh::Entity_ID top_f = surf_mesh->entity_get_parent(AmanziMesh::CELL, sc);
     double top_z = subsurf_mesh->face_centroid(top_f)[z_dim];
-    
+
+    // the water table is at the face above the first saturated cell
     double wt_z = std::numeric_limits<double>::quiet_NaN();
-    for (int i=0; i!=subsurf_mesh->cells_of_column(sc).size(); ++i) {
-      AmanziMesh::Entity_ID c = subsurf_mesh->cells_of_column(sc)[i];
-      if (sat_c[0][c] == 0.) {
-        // find the face above
-        AmanziMesh::Entity_ID f_up = subsurf_mesh->faces_of_column(sc)[i];
-        wt_z = subsurf_mesh->face_centroid(f_up)[z_dim];
-        break;
-      }
+    if (crossing_[sc] >= 0) {
+      AmanziMesh::Entity_ID f_up = columns_.faces(sc)[crossing_[sc]];
+      wt_z = subsurf_mesh->face_centroid(f_up)[z_dim];
     }
     res_c[0][sc] = top_z - wt_z;
   }
@@ -30,8 +30,11 @@ Evaluator name: `"water table depth`"
 
 #pragma once
 
+#include <vector>
+
 #include "Factory.hh"
 #include "secondary_variable_field_evaluator.hh"
+#include "column_index.hh"
 
 namespace Amanzi {
 namespace Flow {
@@ -64,6 +67,11 @@ class WaterTableDepthEvaluator : public SecondaryVariableFieldEvaluator {
   Key sat_key_;
   Key domain_, domain_ss_;
 
+  // column-major index of the subsurface mesh, and the crossing cell of
+  // each column
+  Operators::ColumnIndex columns_;
+  std::vector<int> crossing_;
+
  private:
   static Utils::RegisteredFactory<FieldEvaluator,WaterTableDepthEvaluator> reg_;
 
@@ -4,6 +4,7 @@
 #include "Teuchos_GlobalMPISession.hpp"
 
 #include "state_evaluators_registration.hh"
+#include "ats_flow_relations_registration.hh"
 #include "VerboseObject_objs.hh"
 
 int main(int argc, char *argv[])
@@ -0,0 +1,51 @@
+#include <iostream>
+#include "UnitTest++.h"
+
+#include "wrm_van_genuchten.hh"
+#include "wrm_tabulated.hh"
+
+TEST(tabulated_vanGenuchten) {
+  using namespace Amanzi::Flow;
+
+  Teuchos::ParameterList plist;
+  plist.set<std::string>("WRM type", "tabulated");
+  plist.set("tabulation tolerance [-]", 1.e-8);
+  Teuchos::ParameterList& vg_list = plist.sublist("tabulated WRM parameters");
+  vg_list.set<std::string>("WRM type", "van Genuchten");
+  vg_list.set("van Genuchten m [-]", 0.3);
+  vg_list.set("van Genuchten alpha [Pa^-1]", 5.e-4);
+  vg_list.set("residual saturation [-]", 0.05);
+
+  WRMTabulated tab(plist);
+  WRMVanGenuchten vG(vg_list);
+
+  // values are within tolerance, and saturation is monotone
+  double sat_prev = 1.0;
+  for (double pc = 0.; pc < 1.e7; pc = 1.5 * pc + 1.) {
+    double sat = tab.saturation(pc);
+    CHECK_CLOSE(vG.saturation(pc), sat, 1.e-8);
+    CHECK(sat <= sat_prev);
+    CHECK(tab.d_saturation(pc) <= 0.);
+    sat_prev = sat;
+  }
+
+  double kr_prev = 0.;
+  for (double s = 0.05; s <= 1.0; s += 0.001) {
+    double kr = tab.k_relative(s);
+    CHECK_CLOSE(vG.k_relative(s), kr, 1.e-8);
+    CHECK(kr >= kr_prev);
+    CHECK(tab.d_k_relative(s) >= 0.);
+    kr_prev = kr;
+  }
+
+  // kr has an unbounded slope at saturation
+  for (double ds : {1.e-4, 1.e-6, 1.e-9, 1.e-12}) {
+    CHECK_CLOSE(vG.k_relative(1. - ds), tab.k_relative(1. - ds), 1.e-8);
+  }
+
+  // derivatives are consistent with the tabulated values
+  double pc = 2000.;
+  double dpc = 1.e-3;
+  CHECK_CLOSE((tab.saturation(pc+dpc) - tab.saturation(pc-dpc)) / (2*dpc),
+              tab.d_saturation(pc), 1.e-9);
+}
@@ -0,0 +1,63 @@
+#include <vector>
+#include "UnitTest++.h"
+
+#include "wrm_van_genuchten.hh"
+
+TEST(vanGenuchten_batch) {
+  using namespace Amanzi::Flow;
+
+  Teuchos::ParameterList plist;
+  plist.set("van Genuchten m [-]", 0.5);
+  plist.set("van Genuchten alpha [Pa^-1]", 1.e-4);
+  plist.set("residual saturation [-]", 0.1);
+  plist.set("smoothing interval width [saturation]", 0.05);
+  plist.set("saturation smoothing interval [Pa]", 100.);
+  WRMVanGenuchten vG(plist);
+
+  // span all branches: saturated, smoothed, and unsmoothed
+  const int n = 200;
+  std::vector<double> pc(n), sat(n), out(n);
+  for (int i=0; i!=n; ++i) {
+    pc[i] = -1000. + i * 500.;
+    sat[i] = 0.11 + i * (0.89 / (n-1));
+  }
+
+  vG.saturation_batch(n, pc.data(), out.data());
+  for (int i=0; i!=n; ++i) CHECK_EQUAL(vG.saturation(pc[i]), out[i]);
+
+  vG.d_saturation_batch(n, pc.data(), out.data());
+  for (int i=0; i!=n; ++i) CHECK_EQUAL(vG.d_saturation(pc[i]), out[i]);
+
+  vG.k_relative_batch(n, sat.data(), out.data());
+  for (int i=0; i!=n; ++i) CHECK_CLOSE(vG.k_relative(sat[i]), out[i], 1.e-15);
+
+  vG.d_k_relative_batch(n, sat.data(), out.data());
+  for (int i=0; i!=n; ++i) CHECK_CLOSE(vG.d_k_relative(sat[i]), out[i], 1.e-12);
+}
+
+
+TEST(vanGenuchten_batch_unsmoothed) {
+  using namespace Amanzi::Flow;
+
+  Teuchos::ParameterList plist;
+  plist.set("van Genuchten m [-]", 0.5);
+  plist.set("van Genuchten alpha [Pa^-1]", 1.e-4);
+  plist.set("residual saturation [-]", 0.1);
+  WRMVanGenuchten vG(plist);
+
+  // saturated entries stay finite without a smoothing interval
+  double pc[4] = { -1.e5, -1., 0., 1.e3 };
+  double out[4];
+  vG.saturation_batch(4, pc, out);
+  for (int i=0; i!=4; ++i) CHECK_EQUAL(vG.saturation(pc[i]), out[i]);
+
+  vG.d_saturation_batch(4, pc, out);
+  for (int i=0; i!=4; ++i) CHECK_EQUAL(vG.d_saturation(pc[i]), out[i]);
+
+  // oversaturated entries, undefined in the scalar method, give kr = 1
+  double sat[3] = { 0.5, 1.0, 1.0 + 1.e-10 };
+  vG.k_relative_batch(3, sat, out);
+  CHECK_CLOSE(vG.k_relative(sat[0]), out[0], 1.e-15);
+  CHECK_EQUAL(1.0, out[1]);
+  CHECK_EQUAL(1.0, out[2]);
+}
@@ -7,6 +7,7 @@
 */
 //! RelPermEvaluator: evaluates relative permeability using water retention models.
 
+#include "boundary_face_index.hh"
 #include "rel_perm_evaluator.hh"
 
 namespace Amanzi {
@@ -168,9 +169,10 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
   Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
   int ncells = res_c.MyLength();
+  if (region_cells_.empty()) region_cells_ = computeRegionCells(*wrms_->first, ncells);
+  applyWRMBatch(wrms_->second, region_cells_, &WRM::k_relative_batch, sat_c[0], res_c[0]);
   for (unsigned int c=0; c!=ncells; ++c) {
-    int index = (*wrms_->first)[c];
-    res_c[0][c] = std::max(wrms_->second[index]->k_relative(sat_c[0][c]), min_val_);
+    res_c[0][c] = std::max(res_c[0][c], min_val_);
   }
 
   // -- Potentially evaluate the model on boundary faces as well.
@@ -180,30 +182,27 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
     Epetra_MultiVector& res_bf = *result->ViewComponent("boundary_face",false);
 
     Teuchos::RCP<const AmanziMesh::Mesh> mesh = result->Mesh();
-    const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
-    const Epetra_Map& face_map = mesh->face_map(false);
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh);
 
     // Evaluate the model to calculate krel.
-    AmanziMesh::Entity_ID_List cells;
     int nbfaces = res_bf.MyLength();
     for (unsigned int bf=0; bf!=nbfaces; ++bf) {
       // given a boundary face, we need the internal cell to choose the right WRM
-      AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-      mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-      AMANZI_ASSERT(cells.size() == 1);
+      AmanziMesh::Entity_ID c = bfs.cell(bf);
+      AMANZI_ASSERT(c >= 0);
 
-      int index = (*wrms_->first)[cells[0]];
+      int index = (*wrms_->first)[c];
       double krel;
       if (boundary_krel_ == BoundaryRelPerm::HARMONIC_MEAN) {
         double krelb = std::max(wrms_->second[index]->k_relative(sat_bf[0][bf]),min_val_);
-        double kreli = std::max(wrms_->second[index]->k_relative(sat_c[0][cells[0]]), min_val_);
+        double kreli = std::max(wrms_->second[index]->k_relative(sat_c[0][c]), min_val_);
         krel = 1.0 / (1.0/krelb + 1.0/kreli);
       } else if (boundary_krel_ == BoundaryRelPerm::ARITHMETIC_MEAN) {
         double krelb = std::max(wrms_->second[index]->k_relative(sat_bf[0][bf]),min_val_);
-        double kreli = std::max(wrms_->second[index]->k_relative(sat_c[0][cells[0]]), min_val_);
+        double kreli = std::max(wrms_->second[index]->k_relative(sat_c[0][c]), min_val_);
         krel = (krelb + kreli)/2.0;
       } else if (boundary_krel_ == BoundaryRelPerm::INTERIOR_PRESSURE) {
-        krel = wrms_->second[index]->k_relative(sat_c[0][cells[0]]);
+        krel = wrms_->second[index]->k_relative(sat_c[0][c]);
       } else if (boundary_krel_ == BoundaryRelPerm::ONE) {
         krel = 1.;
       } else {
@@ -221,14 +220,13 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
     Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh = S->GetMesh(surf_domain_);
     Teuchos::RCP<const AmanziMesh::Mesh> mesh = result->Mesh();
-    const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
-    const Epetra_Map& face_map = mesh->face_map(false);
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh);
 
     unsigned int nsurf_cells = surf_mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
     for (unsigned int sc=0; sc!=nsurf_cells; ++sc) {
       // need to map from surface quantity on cells to subsurface boundary_face quantity
       AmanziMesh::Entity_ID f = surf_mesh->entity_get_parent(AmanziMesh::CELL, sc);
-      AmanziMesh::Entity_ID bf = vandelay_map.LID(face_map.GID(f));
+      AmanziMesh::Entity_ID bf = bfs.boundary_face(f);
 
       res_bf[0][bf] = std::max(surf_kr[0][sc], min_val_);
     }
@@ -286,9 +284,9 @@ void RelPermEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>
     Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
     int ncells = res_c.MyLength();
+    if (region_cells_.empty()) region_cells_ = computeRegionCells(*wrms_->first, ncells);
+    applyWRMBatch(wrms_->second, region_cells_, &WRM::d_k_relative_batch, sat_c[0], res_c[0]);
     for (unsigned int c=0; c!=ncells; ++c) {
-      int index = (*wrms_->first)[c];
-      res_c[0][c] = wrms_->second[index]->d_k_relative(sat_c[0][c]);
       AMANZI_ASSERT(res_c[0][c] >= 0.);
     }
 
@@ -347,14 +345,13 @@ void RelPermEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>
 
       Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh = S->GetMesh(surf_domain_);
       Teuchos::RCP<const AmanziMesh::Mesh> mesh = result->Mesh();
-      const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
-      const Epetra_Map& face_map = mesh->face_map(false);
+      const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh);
 
       unsigned int nsurf_cells = surf_mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
       for (unsigned int sc=0; sc!=nsurf_cells; ++sc) {
         // need to map from surface quantity on cells to subsurface boundary_face quantity
         AmanziMesh::Entity_ID f = surf_mesh->entity_get_parent(AmanziMesh::CELL, sc);
-        AmanziMesh::Entity_ID bf = vandelay_map.LID(face_map.GID(f));
+        AmanziMesh::Entity_ID bf = bfs.boundary_face(f);
 
         //        res_bf[0][bf] = std::max(surf_kr[0][sc], min_val_);
         res_bf[0][bf] = 0.;
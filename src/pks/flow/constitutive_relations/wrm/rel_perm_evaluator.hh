@@ -101,6 +101,7 @@ class RelPermEvaluator : public SecondaryVariableFieldEvaluator {
   void InitializeFromPlist_();
 
   Teuchos::RCP<WRMPartition> wrms_;
+  std::vector<std::vector<int> > region_cells_;
   Key sat_key_;
   Key dens_key_;
   Key visc_key_;
@@ -52,9 +52,26 @@ public:
   virtual double suction_head(double saturation){return 0.;};
   virtual double d_suction_head(double saturation){return 0.;};
 
+  // batched methods, evaluating over n contiguous values.  The defaults
+  // simply loop over the scalar methods; models override these where the
+  // loop can be written to vectorize.
+  virtual void k_relative_batch(int n, const double* saturation, double* kr) {
+    for (int i=0; i!=n; ++i) kr[i] = k_relative(saturation[i]);
+  }
+  virtual void d_k_relative_batch(int n, const double* saturation, double* dkr) {
+    for (int i=0; i!=n; ++i) dkr[i] = d_k_relative(saturation[i]);
+  }
+  virtual void saturation_batch(int n, const double* pc, double* sat) {
+    for (int i=0; i!=n; ++i) sat[i] = saturation(pc[i]);
+  }
+  virtual void d_saturation_batch(int n, const double* pc, double* dsat) {
+    for (int i=0; i!=n; ++i) dsat[i] = d_saturation(pc[i]);
+  }
+
 };
 
 typedef double(WRM::*KRelFn)(double pc);
+typedef void(WRM::*WRMBatchFn)(int n, const double* in, double* out);
 
 } //namespace
 } //namespace
@@ -7,6 +7,7 @@
 */
 
 
+#include "boundary_face_index.hh"
 #include "wrm_evaluator.hh"
 #include "wrm_factory.hh"
 
@@ -35,7 +36,8 @@ WRMEvaluator::WRMEvaluator(const WRMEvaluator& other) :
     SecondaryVariablesFieldEvaluator(other),
     calc_other_sat_(other.calc_other_sat_),
     cap_pres_key_(other.cap_pres_key_),
-    wrms_(other.wrms_) {}
+    wrms_(other.wrms_),
+    region_cells_(other.region_cells_) {}
 
 
 Teuchos::RCP<FieldEvaluator> WRMEvaluator::Clone() const {
@@ -87,9 +89,8 @@ void WRMEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
   // calculate cell values
   AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->saturation(pres_c[0][c]);
-  }
+  if (region_cells_.empty()) region_cells_ = computeRegionCells(*wrms_->first, ncells);
+  applyWRMBatch(wrms_->second, region_cells_, &WRM::saturation_batch, pres_c[0], sat_c[0]);
 
   // Potentially do face values as well.
   if (results[0]->HasComponent("boundary_face")) {
@@ -99,19 +100,16 @@ void WRMEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
     // Need to get boundary face's inner cell to specify the WRM.
     Teuchos::RCP<const AmanziMesh::Mesh> mesh = results[0]->Mesh();
-    const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
-    const Epetra_Map& face_map = mesh->face_map(false);
-    AmanziMesh::Entity_ID_List cells;
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh);
 
     // calculate boundary face values
     int nbfaces = sat_bf.MyLength();
     for (int bf=0; bf!=nbfaces; ++bf) {
       // given a boundary face, we need the internal cell to choose the right WRM
-      AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-      mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-      AMANZI_ASSERT(cells.size() == 1);
+      AmanziMesh::Entity_ID c = bfs.cell(bf);
+      AMANZI_ASSERT(c >= 0);
 
-      int index = (*wrms_->first)[cells[0]];
+      int index = (*wrms_->first)[c];
       sat_bf[0][bf] = wrms_->second[index]->saturation(pres_bf[0][bf]);
     }
   }
@@ -154,9 +152,8 @@ void WRMEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
 
   // calculate cell values
   AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->d_saturation(pres_c[0][c]);
-  }
+  if (region_cells_.empty()) region_cells_ = computeRegionCells(*wrms_->first, ncells);
+  applyWRMBatch(wrms_->second, region_cells_, &WRM::d_saturation_batch, pres_c[0], sat_c[0]);
 
   // Potentially do face values as well.
   if (results[0]->HasComponent("boundary_face")) {
@@ -166,19 +163,16 @@ void WRMEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
 
     // Need to get boundary face's inner cell to specify the WRM.
     Teuchos::RCP<const AmanziMesh::Mesh> mesh = results[0]->Mesh();
-    const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
-    const Epetra_Map& face_map = mesh->face_map(false);
-    AmanziMesh::Entity_ID_List cells;
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh);
 
     // calculate boundary face values
     int nbfaces = sat_bf.MyLength();
     for (int bf=0; bf!=nbfaces; ++bf) {
       // given a boundary face, we need the internal cell to choose the right WRM
-      AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-      mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-      AMANZI_ASSERT(cells.size() == 1);
+      AmanziMesh::Entity_ID c = bfs.cell(bf);
+      AMANZI_ASSERT(c >= 0);
 
-      int index = (*wrms_->first)[cells[0]];
+      int index = (*wrms_->first)[c];
       sat_bf[0][bf] = wrms_->second[index]->d_saturation(pres_bf[0][bf]);
     }
   }
@@ -57,5 +57,43 @@ createWRMPermafrostModelPartition(Teuchos::ParameterList& plist,
   return Teuchos::rcp(new WRMPermafrostModelPartition(wrms->first, pm_list));
 }
 
+
+std::vector<std::vector<int> >
+computeRegionCells(const Functions::MeshPartition& partition, int ncells) {
+  std::vector<std::vector<int> > region_cells;
+  for (int c=0; c!=ncells; ++c) {
+    int index = partition[c];
+    if (index < 0) continue;
+    if (index >= region_cells.size()) region_cells.resize(index+1);
+    region_cells[index].push_back(c);
+  }
+  return region_cells;
+}
+
+
+void
+applyWRMBatch(const WRMList& wrms,
+              const std::vector<std::vector<int> >& region_cells,
+              WRMBatchFn fn, const double* in, double* out) {
+  std::vector<double> in_buf, out_buf;
+  for (int r=0; r!=region_cells.size(); ++r) {
+    const auto& cells = region_cells[r];
+    int n = cells.size();
+    if (n == 0) continue;
+
+    WRM& wrm = *wrms[r];
+    if (cells.back() - cells.front() + 1 == n) {
+      // contiguous, call directly on the data
+      (wrm.*fn)(n, in + cells.front(), out + cells.front());
+    } else {
+      in_buf.resize(n);
+      out_buf.resize(n);
+      for (int i=0; i!=n; ++i) in_buf[i] = in[cells[i]];
+      (wrm.*fn)(n, in_buf.data(), out_buf.data());
+      for (int i=0; i!=n; ++i) out[cells[i]] = out_buf[i];
+    }
+  }
+}
+
 } // namespace
 } // namespace
@@ -46,6 +46,19 @@ Teuchos::RCP<WRMPermafrostModelPartition>
 createWRMPermafrostModelPartition(Teuchos::ParameterList& plist,
         Teuchos::RCP<WRMPartition>& wrms);
 
+// For each region of the partition, the list of cells in [0,ncells) that lie
+// in that region, in increasing order.
+std::vector<std::vector<int> >
+computeRegionCells(const Functions::MeshPartition& partition, int ncells);
+
+// Evaluates out[c] = fn(in[c]) for all cells, calling the batched WRM method
+// once per region.  Regions whose cells are not contiguous are gathered into
+// and scattered from a contiguous buffer.
+void
+applyWRMBatch(const WRMList& wrms,
+              const std::vector<std::vector<int> >& region_cells,
+              WRMBatchFn fn, const double* in, double* out);
+
 } // namespace
 } // namespace
 
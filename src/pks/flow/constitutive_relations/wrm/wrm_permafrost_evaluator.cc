@@ -7,6 +7,7 @@
   Authors: Ethan Coon (ecoon@lanl.gov)
 */
 
+#include "boundary_face_index.hh"
 #include "wrm_permafrost_evaluator.hh"
 #include "wrm_partition.hh"
 
@@ -189,19 +190,16 @@ void WRMPermafrostEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
     // Need to get boundary face's inner cell to specify the WRM.
     Teuchos::RCP<const AmanziMesh::Mesh> mesh = results[0]->Mesh();
-    const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
-    const Epetra_Map& face_map = mesh->face_map(false);
-    AmanziMesh::Entity_ID_List cells;
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh);
 
     // calculate boundary face values
     int nbfaces = satg_bf.MyLength();
     for (int bf=0; bf!=nbfaces; ++bf) {
       // given a boundary face, we need the internal cell to choose the right WRM
-      AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-      mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-      AMANZI_ASSERT(cells.size() == 1);
+      AmanziMesh::Entity_ID c = bfs.cell(bf);
+      AMANZI_ASSERT(c >= 0);
 
-      int i = (*permafrost_models_->first)[cells[0]];
+      int i = (*permafrost_models_->first)[c];
       permafrost_models_->second[i]
           ->saturations(pc_liq_bf[0][bf], pc_ice_bf[0][bf], sats);
       satg_bf[0][bf] = sats[0];
@@ -271,20 +269,17 @@ WRMPermafrostEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State
 
     // Need to get boundary face's inner cell to specify the WRM.
     Teuchos::RCP<const AmanziMesh::Mesh> mesh = results[0]->Mesh();
-    const Epetra_Map& face_map = mesh->face_map(false);
-    const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
-    AmanziMesh::Entity_ID_List cells;
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh);
 
     if (wrt_key == pc_liq_key_) {
       // calculate boundary face values
       int nbfaces = satl_bf.MyLength();
       for (int bf=0; bf!=nbfaces; ++bf) {
         // given a boundary face, we need the internal cell to choose the right WRM
-        AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-        mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-        AMANZI_ASSERT(cells.size() == 1);
+        AmanziMesh::Entity_ID c = bfs.cell(bf);
+        AMANZI_ASSERT(c >= 0);
 
-        int i = (*permafrost_models_->first)[cells[0]];
+        int i = (*permafrost_models_->first)[c];
         permafrost_models_->second[i]->dsaturations_dpc_liq(
             pc_liq_bf[0][bf], pc_ice_bf[0][bf], dsats);
         satg_bf[0][bf] = dsats[0];
@@ -297,11 +292,10 @@ WRMPermafrostEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State
       int nbfaces = satl_bf.MyLength();
       for (int bf=0; bf!=nbfaces; ++bf) {
         // given a boundary face, we need the internal cell to choose the right WRM
-        AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-        mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-        AMANZI_ASSERT(cells.size() == 1);
+        AmanziMesh::Entity_ID c = bfs.cell(bf);
+        AMANZI_ASSERT(c >= 0);
 
-        int i = (*permafrost_models_->first)[cells[0]];
+        int i = (*permafrost_models_->first)[c];
         permafrost_models_->second[i]->dsaturations_dpc_ice(
             pc_liq_bf[0][bf], pc_ice_bf[0][bf], dsats);
         satg_bf[0][bf] = dsats[0];
@@ -0,0 +1,169 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+*/
+//! WRMTabulated : a table-lookup wrapper around another WRM.
+
+#include <cmath>
+#include "errors.hh"
+
+#include "wrm_factory.hh"
+#include "wrm_tabulated.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+/* ******************************************************************
+ * Fit the interpolant, limiting slopes following Fritsch & Carlson.
+ ****************************************************************** */
+void UniformHermiteTable::Setup(double x0, double x1, int n,
+        const std::function<double(double)>& f,
+        const std::function<double(double)>& df) {
+  x0_ = x0;
+  x1_ = x1;
+  double h = (x1 - x0) / n;
+  inv_h_ = 1.0 / h;
+
+  f_.resize(n+1);
+  std::vector<double> m(n+1);
+  for (int i=0; i!=n+1; ++i) {
+    double x = (i == n) ? x1 : x0 + i*h;
+    f_[i] = f(x);
+    m[i] = df(x);
+    if (!std::isfinite(m[i])) m[i] = 0.;
+  }
+
+  for (int i=0; i!=n; ++i) {
+    double delta = (f_[i+1] - f_[i]) / h;
+    if (delta == 0.) {
+      m[i] = 0.;
+      m[i+1] = 0.;
+    } else {
+      double a = m[i] / delta;
+      double b = m[i+1] / delta;
+      if (a < 0.) { m[i] = 0.; a = 0.; }
+      if (b < 0.) { m[i+1] = 0.; b = 0.; }
+      double r2 = a*a + b*b;
+      if (r2 > 9.) {
+        double tau = 3. / std::sqrt(r2);
+        m[i] = tau * a * delta;
+        m[i+1] = tau * b * delta;
+      }
+    }
+  }
+
+  hm_.resize(n+1);
+  for (int i=0; i!=n+1; ++i) hm_[i] = m[i] * h;
+}
+
+
+/* ******************************************************************
+ * Setup fundamental parameters for this model.
+ ****************************************************************** */
+WRMTabulated::WRMTabulated(Teuchos::ParameterList& plist) {
+  InitializeFromPlist_(plist);
+};
+
+
+void WRMTabulated::InitializeFromPlist_(Teuchos::ParameterList& plist) {
+  if (!plist.isSublist("tabulated WRM parameters")) {
+    Errors::Message msg("WRMTabulated: missing sublist \"tabulated WRM parameters\"");
+    Exceptions::amanzi_throw(msg);
+  }
+  WRMFactory fac;
+  wrm_ = fac.createWRM(plist.sublist("tabulated WRM parameters"));
+
+  tol_ = plist.get<double>("tabulation tolerance [-]", 1.e-8);
+  max_intervals_ = plist.get<int>("maximum tabulation intervals", 1048576);
+  double pc_max = plist.get<double>("maximum tabulated capillary pressure [Pa]", 1.e8);
+
+  // saturation, on a grid uniform in u = log(1 + pc)
+  auto sat = [this](double u) { return wrm_->saturation(std::expm1(u)); };
+  auto dsat = [this](double u) { return wrm_->d_saturation(std::expm1(u)) * std::exp(u); };
+  Tabulate_(sat_table_, 0., std::log1p(pc_max), sat, dsat, "saturation");
+
+  // relative permeability, on a grid uniform in v = -log(1 - se), which
+  // resolves the infinite slope of most curves at saturation.  The table
+  // stops short of se = 1, above which the wrapped WRM is called.
+  double sr = wrm_->residualSaturation();
+  double se_max = plist.get<double>("maximum tabulated effective saturation [-]", 1. - 1.e-10);
+  kr_s0_ = sr;
+  kr_s1_ = sr + (1. - sr) * se_max;
+  log_1msr_ = std::log(1. - sr);
+  auto s_of_v = [sr](double v) { return 1. - (1. - sr) * std::exp(-v); };
+  auto kr = [this,s_of_v](double v) { return wrm_->k_relative(s_of_v(v)); };
+  auto dkr = [this,s_of_v](double v) {
+    double s = s_of_v(v);
+    return wrm_->d_k_relative(s) * (1. - s);
+  };
+  Tabulate_(kr_table_, 0., -std::log1p(-se_max), kr, dkr, "relative permeability");
+}
+
+
+void WRMTabulated::Tabulate_(UniformHermiteTable& table, double x0, double x1,
+        const std::function<double(double)>& f,
+        const std::function<double(double)>& df,
+        const std::string& name) {
+  int n = 64;
+  while (true) {
+    table.Setup(x0, x1, n, f, df);
+
+    // sample the error within each interval
+    double h = (x1 - x0) / n;
+    double err = 0.;
+    for (int i=0; i!=n; ++i) {
+      for (double t : {0.25, 0.5, 0.75}) {
+        double x = x0 + (i + t)*h;
+        err = std::max(err, std::abs(table.Value(x) - f(x)));
+      }
+    }
+    if (err <= tol_) return;
+
+    n *= 2;
+    if (n > max_intervals_) {
+      Errors::Message msg;
+      msg << "WRMTabulated: cannot tabulate " << name << " to tolerance " << tol_
+          << " with at most " << max_intervals_ << " intervals (error = " << err << ")";
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+}
+
+
+/* ******************************************************************
+ * Lookups, falling back to the wrapped WRM outside of the tables.
+ ****************************************************************** */
+double WRMTabulated::k_relative(double s) {
+  if (s < kr_s0_ || s > kr_s1_) return wrm_->k_relative(s);
+  return kr_table_.Value(log_1msr_ - std::log(1. - s));
+}
+
+double WRMTabulated::d_k_relative(double s) {
+  if (s < kr_s0_ || s > kr_s1_) return wrm_->d_k_relative(s);
+  return kr_table_.Derivative(log_1msr_ - std::log(1. - s)) / (1. - s);
+}
+
+double WRMTabulated::saturation(double pc) {
+  if (pc <= 0.) return wrm_->saturation(pc);
+  double u = std::log1p(pc);
+  return sat_table_.InRange(u) ? sat_table_.Value(u) : wrm_->saturation(pc);
+}
+
+double WRMTabulated::d_saturation(double pc) {
+  if (pc <= 0.) return wrm_->d_saturation(pc);
+  double u = std::log1p(pc);
+  return sat_table_.InRange(u) ? sat_table_.Derivative(u) / (1. + pc) : wrm_->d_saturation(pc);
+}
+
+
+void WRMTabulated::k_relative_batch(int n, const double* sat, double* kr) {
+  for (int i=0; i!=n; ++i) kr[i] = k_relative(sat[i]);
+}
+
+void WRMTabulated::saturation_batch(int n, const double* pc, double* sat) {
+  for (int i=0; i!=n; ++i) sat[i] = saturation(pc[i]);
+}
+
+}  // namespace
+}  // namespace
@@ -0,0 +1,168 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! WRMTabulated : a table-lookup wrapper around another WRM.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+*/
+
+/*!
+
+Wraps any other WRM, precomputing saturation as a function of capillary
+pressure and relative permeability as a function of saturation as monotone,
+piecewise cubic Hermite splines on setup.  Evaluation is then a table lookup,
+which is much cheaper than the pow-heavy analytic curves.  Derivatives are
+those of the splines, so they are consistent with the tabulated values.
+
+The table is refined (doubling the number of intervals) until the maximum
+error against the wrapped WRM, sampled within each interval, is below the
+requested tolerance.  Saturation is tabulated on a grid uniform in
+log(1 + pc).  Relative permeability typically has an infinite slope at
+saturation (e.g. Mualem-van Genuchten), which no uniform grid in saturation
+resolves, so it is tabulated on a grid uniform in -log(1 - se), where se is
+the effective saturation, up to a maximum se just below 1.  Outside of the
+tabulated ranges, the wrapped WRM is called directly.
+
+Since permafrost WRMs call their underlying WRM many times per cell in their
+implicit solves, using a tabulated WRM in a permafrost model accelerates the
+permafrost model as well.
+
+.. _WRM-tabulated-spec:
+.. admonition:: WRM-tabulated-spec
+
+    * `"region`" ``[string]`` Region to which this applies
+    * `"tabulated WRM parameters`" ``[WRM-typedinline-spec]`` The WRM to tabulate.
+    * `"tabulation tolerance [-]`" ``[double]`` **1.e-8** Maximum absolute
+      error in saturation and relative permeability.
+    * `"maximum tabulated capillary pressure [Pa]`" ``[double]`` **1.e8**
+      Saturation is tabulated on [0, this].
+    * `"maximum tabulated effective saturation [-]`" ``[double]`` **1 - 1.e-10**
+      Relative permeability is tabulated on [0, this] in effective saturation.
+    * `"maximum tabulation intervals`" ``[int]`` **1048576** Error if the
+      tolerance cannot be met with this many intervals.
+
+Example:
+
+.. code-block:: xml
+
+    <ParameterList name="peat" type="ParameterList">
+      <Parameter name="region" type="string" value="peat" />
+      <Parameter name="WRM type" type="string" value="tabulated" />
+      <Parameter name="tabulation tolerance [-]" type="double" value="1.e-8" />
+      <ParameterList name="tabulated WRM parameters" type="ParameterList">
+        <Parameter name="WRM type" type="string" value="van Genuchten" />
+        <Parameter name="van Genuchten alpha [Pa^-1]" type="double" value="5.e-4" />
+        <Parameter name="van Genuchten m [-]" type="double" value="0.3" />
+        <Parameter name="residual saturation [-]" type="double" value="0.05" />
+      </ParameterList>
+    </ParameterList>
+
+*/
+
+#ifndef ATS_FLOWRELATIONS_WRM_TABULATED_
+#define ATS_FLOWRELATIONS_WRM_TABULATED_
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "wrm.hh"
+#include "Factory.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+// A monotone, piecewise cubic Hermite interpolant on a uniform grid.
+class UniformHermiteTable {
+ public:
+  UniformHermiteTable() : x0_(0.), x1_(0.), inv_h_(0.) {}
+
+  // Fits values f and derivatives df of a function on n uniform intervals
+  // of [x0, x1].  Derivatives are limited to keep the interpolant monotone
+  // wherever the data is.
+  void Setup(double x0, double x1, int n,
+             const std::function<double(double)>& f,
+             const std::function<double(double)>& df);
+
+  bool InRange(double x) const { return x >= x0_ && x <= x1_; }
+
+  double Value(double x) const {
+    int i; double t;
+    Locate_(x, i, t);
+    double t2 = t*t, t3 = t2*t;
+    return (2*t3 - 3*t2 + 1) * f_[i] + (t3 - 2*t2 + t) * hm_[i]
+        + (-2*t3 + 3*t2) * f_[i+1] + (t3 - t2) * hm_[i+1];
+  }
+
+  double Derivative(double x) const {
+    int i; double t;
+    Locate_(x, i, t);
+    double t2 = t*t;
+    return ((6*t2 - 6*t) * f_[i] + (3*t2 - 4*t + 1) * hm_[i]
+            + (-6*t2 + 6*t) * f_[i+1] + (3*t2 - 2*t) * hm_[i+1]) * inv_h_;
+  }
+
+  int size() const { return f_.size() - 1; }
+
+ private:
+  void Locate_(double x, int& i, double& t) const {
+    double u = (x - x0_) * inv_h_;
+    i = std::min(std::max(static_cast<int>(u), 0), size()-1);
+    t = u - i;
+  }
+
+ private:
+  double x0_, x1_, inv_h_;
+  std::vector<double> f_;   // values at nodes
+  std::vector<double> hm_;  // derivatives at nodes, scaled by the spacing
+};
+
+
+class WRMTabulated : public WRM {
+
+public:
+  explicit WRMTabulated(Teuchos::ParameterList& plist);
+
+  // required methods from the base class
+  double k_relative(double saturation);
+  double d_k_relative(double saturation);
+  double saturation(double pc);
+  double d_saturation(double pc);
+  double capillaryPressure(double saturation) { return wrm_->capillaryPressure(saturation); }
+  double d_capillaryPressure(double saturation) { return wrm_->d_capillaryPressure(saturation); }
+  double residualSaturation() { return wrm_->residualSaturation(); }
+  double suction_head(double saturation) { return wrm_->suction_head(saturation); }
+  double d_suction_head(double saturation) { return wrm_->d_suction_head(saturation); }
+
+  // batched methods
+  void k_relative_batch(int n, const double* saturation, double* kr);
+  void saturation_batch(int n, const double* pc, double* sat);
+
+ private:
+  void InitializeFromPlist_(Teuchos::ParameterList& plist);
+
+  // refine a table until it meets the tolerance
+  void Tabulate_(UniformHermiteTable& table, double x0, double x1,
+                 const std::function<double(double)>& f,
+                 const std::function<double(double)>& df,
+                 const std::string& name);
+
+  Teuchos::RCP<WRM> wrm_;
+  double tol_;
+  int max_intervals_;
+
+  UniformHermiteTable sat_table_;  // saturation as a function of log(1 + pc)
+  UniformHermiteTable kr_table_;   // k_relative as a function of -log(1 - se)
+  double kr_s0_, kr_s1_;           // saturation range of kr_table_
+  double log_1msr_;                // log(1 - sr)
+
+  static Utils::RegisteredFactory<WRM,WRMTabulated> factory_;
+};
+
+} //namespace
+} //namespace
+
+#endif
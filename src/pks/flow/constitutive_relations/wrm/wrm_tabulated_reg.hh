@@ -0,0 +1,16 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+*/
+//! WRMTabulated : a table-lookup wrapper around another WRM.
+
+#include "wrm_tabulated.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+Utils::RegisteredFactory<WRM,WRMTabulated> WRMTabulated::factory_("tabulated");
+
+}  // namespace
+}  // namespace
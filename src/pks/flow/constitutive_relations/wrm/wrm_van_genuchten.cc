@@ -5,6 +5,7 @@
   Konstantin Lipnikov (lipnikov@lanl.gov)
 */
 
+#include <algorithm>
 #include <cmath>
 #include "dbc.hh"
 #include "errors.hh"
@@ -133,6 +134,84 @@ double WRMVanGenuchten::d_capillaryPressure(double s) {
 }
 
 
+/* ******************************************************************
+ * Batched versions of the above.
+ *
+ * The analytic curve is evaluated for every entry in a straight-line loop
+ * (inputs in the smoothed or saturated ranges are clamped to keep it finite),
+ * and the rare entries in the smoothing intervals are patched in a second
+ * pass.  Results agree with the scalar methods to round-off, except that
+ * sat > 1 with no smoothing interval, where the scalar methods are
+ * undefined, gives kr = 1 and dkr = 0.
+ ****************************************************************** */
+void WRMVanGenuchten::k_relative_batch(int n, const double* sat, double* kr) {
+  const double minv = 1.0 / m_;
+  for (int i=0; i!=n; ++i) {
+    double se = (std::min(sat[i], s0_) - sr_)/(1-sr_);
+    double y = 1.0 - pow(1.0 - pow(se, minv), m_);
+    kr[i] = (function_ == FLOW_WRM_MUALEM) ? pow(se, l_) * (y*y) : se * se * y;
+  }
+
+  if (s0_ < 1.0) {
+    for (int i=0; i!=n; ++i) {
+      if (sat[i] > s0_) kr[i] = (sat[i] == 1.0) ? 1.0 : fit_kr_(sat[i]);
+    }
+  }
+}
+
+
+void WRMVanGenuchten::d_k_relative_batch(int n, const double* sat, double* dkr) {
+  const double minv = 1.0 / m_;
+  for (int i=0; i!=n; ++i) {
+    double se = (std::min(sat[i], s0_) - sr_)/(1-sr_);
+    double x = pow(se, minv);
+    double y = pow(1.0 - x, m_);
+    double dkdse = (function_ == FLOW_WRM_MUALEM) ?
+                   (1.0 - y) * (l_ * (1.0 - y) + 2 * x * y / (1.0 - x)) * pow(se, l_ - 1.0) :
+                   (2 * (1.0 - y) + x / (1.0 - x)) * se;
+    bool degenerate = (fabs(1.0 - x) < FLOW_WRM_TOLERANCE) || (fabs(x) < FLOW_WRM_TOLERANCE);
+    dkr[i] = degenerate ? 0.0 : dkdse / (1 - sr_);
+  }
+
+  if (s0_ < 1.0) {
+    for (int i=0; i!=n; ++i) {
+      if (sat[i] > s0_) dkr[i] = (sat[i] == 1.0) ? 0.0 : fit_kr_.Derivative(sat[i]);
+    }
+  }
+}
+
+
+void WRMVanGenuchten::saturation_batch(int n, const double* pc, double* sat) {
+  for (int i=0; i!=n; ++i) {
+    double pc_vg = std::max(pc[i], pc0_);
+    double sat_vg = std::pow(1.0 + std::pow(alpha_*pc_vg, n_), -m_) * (1.0 - sr_) + sr_;
+    sat[i] = (pc[i] > pc0_) ? sat_vg : 1.0;
+  }
+
+  if (pc0_ > 0.) {
+    for (int i=0; i!=n; ++i) {
+      if (pc[i] > 0. && pc[i] <= pc0_) sat[i] = fit_s_(pc[i]);
+    }
+  }
+}
+
+
+void WRMVanGenuchten::d_saturation_batch(int n, const double* pc, double* dsat) {
+  for (int i=0; i!=n; ++i) {
+    double pc_vg = std::max(pc[i], pc0_);
+    double dsat_vg = -m_*n_ * std::pow(1.0 + std::pow(alpha_*pc_vg, n_), -m_-1.0)
+                     * std::pow(alpha_*pc_vg, n_-1) * alpha_ * (1.0 - sr_);
+    dsat[i] = (pc[i] > pc0_) ? dsat_vg : 0.0;
+  }
+
+  if (pc0_ > 0.) {
+    for (int i=0; i!=n; ++i) {
+      if (pc[i] > 0. && pc[i] <= pc0_) dsat[i] = fit_s_.Derivative(pc[i]);
+    }
+  }
+}
+
+
 void WRMVanGenuchten::InitializeFromPlist_() {
   std::string fname = plist_.get<std::string>("Krel function name", "Mualem");
   if (fname == std::string("Mualem")) {
@@ -73,6 +73,12 @@ public:
   double suction_head(double saturation);
   double d_suction_head(double saturation);
 
+  // batched methods
+  void k_relative_batch(int n, const double* saturation, double* kr);
+  void d_k_relative_batch(int n, const double* saturation, double* dkr);
+  void saturation_batch(int n, const double* pc, double* sat);
+  void d_saturation_batch(int n, const double* pc, double* dsat);
+
  private:
   void InitializeFromPlist_();
 
@@ -41,6 +41,8 @@ Interfrost::AddAccumulation_(const Teuchos::Ptr<CompositeVector>& g) {
 void
 Interfrost::UpdatePreconditioner(double t,
         Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   // VerboseObject stuff.
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_HIGH))
@@ -12,6 +12,7 @@ Authors: Ethan Coon (ecoon@lanl.gov)
 
 #include "overland_pressure.hh"
 #include "Op.hh"
+#include "pk_helpers.hh"
 
 namespace Amanzi {
 namespace Flow {
@@ -58,34 +59,40 @@ void OverlandPressureFlow::FunctionalResidual( double t_old,
   // unnecessary here if not debeugging, but doesn't hurt either
   S_next_->GetFieldEvaluator(potential_key_)->HasFieldChanged(S_next_.ptr(), name_);
 
-  // dump u_old, u_new
-  db_->WriteCellInfo(true);
-  std::vector<std::string> vnames;
-  vnames.push_back("p_old");
-  vnames.push_back("p_new");
-  vnames.push_back("z");
-  vnames.push_back("h_old");
-  vnames.push_back("h_new");
-  vnames.push_back("h+z");
-  if (plist_->isSublist("overland conductivity subgrid evaluator")) {
-    vnames.push_back("pd - dd");
-    vnames.push_back("frac_cond");
-  }
+  // debugger output is only gathered if it will be written
+  bool debug = isDebuggerActive(*db_, *mesh_, db_verbosity_);
+  Teuchos::RCP<Teuchos::TimeMonitor> monitor = MonitorResidual_();
+
+  if (debug) {
+    // dump u_old, u_new
+    db_->WriteCellInfo(true);
+    std::vector<std::string> vnames;
+    vnames.push_back("p_old");
+    vnames.push_back("p_new");
+    vnames.push_back("z");
+    vnames.push_back("h_old");
+    vnames.push_back("h_new");
+    vnames.push_back("h+z");
+    if (plist_->isSublist("overland conductivity subgrid evaluator")) {
+      vnames.push_back("pd - dd");
+      vnames.push_back("frac_cond");
+    }
 
-  std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
-  vecs.push_back(S_inter_->GetFieldData(key_).ptr());
-  vecs.push_back(u.ptr());
+    std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
+    vecs.push_back(S_inter_->GetFieldData(key_).ptr());
+    vecs.push_back(u.ptr());
 
-  vecs.push_back(S_inter_->GetFieldData(elev_key_).ptr());
-  vecs.push_back(S_inter_->GetFieldData(pd_key_).ptr());
-  vecs.push_back(S_next_->GetFieldData(pd_key_).ptr());
-  vecs.push_back(S_next_->GetFieldData(potential_key_).ptr());
+    vecs.push_back(S_inter_->GetFieldData(elev_key_).ptr());
+    vecs.push_back(S_inter_->GetFieldData(pd_key_).ptr());
+    vecs.push_back(S_next_->GetFieldData(pd_key_).ptr());
+    vecs.push_back(S_next_->GetFieldData(potential_key_).ptr());
 
-  if (plist_->isSublist("overland conductivity subgrid evaluator")) {
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"mobile_depth")).ptr());
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"fractional_conductance")).ptr());
+    if (plist_->isSublist("overland conductivity subgrid evaluator")) {
+      vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"mobile_depth")).ptr());
+      vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"fractional_conductance")).ptr());
+    }
+    db_->WriteVectors(vnames, vecs, true);
   }
-  db_->WriteVectors(vnames, vecs, true);
 
   // update boundary conditions
   bc_head_->Compute(S_next_->time());
@@ -104,31 +111,37 @@ void OverlandPressureFlow::FunctionalResidual( double t_old,
   // diffusion term, treated implicitly
   ApplyDiffusion_(S_next_.ptr(), res.ptr());
 
-  db_->WriteBoundaryConditions(bc_markers(), bc_values());
-  if (S_next_->HasField(Keys::getKey(domain_,"unfrozen_fraction"))) {
-    Key uf_key = Keys::getKey(domain_,"unfrozen_fraction");
-    S_next_->GetFieldEvaluator(uf_key)->HasFieldChanged(S_next_.ptr(), name_);
-    vnames.resize(2);
-    vecs.resize(2);
-    vnames[0] = "uf_frac_old";
-    vnames[1] = "uf_frac_new";
-    vecs[0] = S_inter_->GetFieldData(uf_key).ptr();
-    vecs[1] = S_next_->GetFieldData(uf_key).ptr();
-    db_->WriteVectors(vnames, vecs, true);
+  // evaluator updates are collective, so are made whether or not this rank
+  // writes debugger output
+  Key uf_key = Keys::getKey(domain_,"unfrozen_fraction");
+  bool has_uf = S_next_->HasField(uf_key);
+  if (has_uf) S_next_->GetFieldEvaluator(uf_key)->HasFieldChanged(S_next_.ptr(), name_);
+
+  if (debug) {
+    db_->WriteBoundaryConditions(bc_markers(), bc_values());
+    if (has_uf) {
+      std::vector<std::string> vnames;
+      vnames.push_back("uf_frac_old");
+      vnames.push_back("uf_frac_new");
+      std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
+      vecs.push_back(S_inter_->GetFieldData(uf_key).ptr());
+      vecs.push_back(S_next_->GetFieldData(uf_key).ptr());
+      db_->WriteVectors(vnames, vecs, true);
+    }
+    db_->WriteVector("uw_dir", S_next_->GetFieldData(flux_dir_key_).ptr(), true);
+    db_->WriteVector("k_s", S_next_->GetFieldData(cond_key_).ptr(), true);
+    db_->WriteVector("k_s_uw", S_next_->GetFieldData(uw_cond_key_).ptr(), true);
+    db_->WriteVector("q_s", S_next_->GetFieldData(flux_key_).ptr(), true);
+    db_->WriteVector("res (diff)", res.ptr(), true);
   }
-  db_->WriteVector("uw_dir", S_next_->GetFieldData(flux_dir_key_).ptr(), true);
-  db_->WriteVector("k_s", S_next_->GetFieldData(cond_key_).ptr(), true);
-  db_->WriteVector("k_s_uw", S_next_->GetFieldData(uw_cond_key_).ptr(), true);
-  db_->WriteVector("q_s", S_next_->GetFieldData(flux_key_).ptr(), true);
-  db_->WriteVector("res (diff)", res.ptr(), true);
 
   // accumulation term
   AddAccumulation_(res.ptr());
-  db_->WriteVector("res (acc)", res.ptr(), true);
+  if (debug) db_->WriteVector("res (acc)", res.ptr(), true);
 
   // add rhs load value
   AddSourceTerms_(res.ptr());
-  db_->WriteVector("res (src)", res.ptr(), true);
+  if (debug) db_->WriteVector("res (src)", res.ptr(), true);
 
 #if DEBUG_RES_FLAG
   if (vo_->os_OK(Teuchos::VERB_HIGH)) {
@@ -167,10 +180,12 @@ int OverlandPressureFlow::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
     *vo_->os() << "Precon application:" << std::endl;
   AMANZI_ASSERT(!precon_scaled_); // otherwise this factor was built into the matrix
 
+  bool debug = isDebuggerActive(*db_, *mesh_, db_verbosity_);
+
   // apply the preconditioner
-  db_->WriteVector("h_res", u->Data().ptr(), true);
+  if (debug) db_->WriteVector("h_res", u->Data().ptr(), true);
   int ierr = preconditioner_->ApplyInverse(*u->Data(), *Pu->Data());
-  db_->WriteVector("PC*h_res (h-coords)", Pu->Data().ptr(), true);
+  if (debug) db_->WriteVector("PC*h_res (h-coords)", Pu->Data().ptr(), true);
 
   // tack on the variable change
   const Epetra_MultiVector& dh_dp =
@@ -182,7 +197,7 @@ int OverlandPressureFlow::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
     Pu_c[0][c] /= dh_dp[0][c];
   }
 
-  db_->WriteVector("PC*h_res (p-coords)", Pu->Data().ptr(), true);
+  if (debug) db_->WriteVector("PC*h_res (p-coords)", Pu->Data().ptr(), true);
   return (ierr > 0) ? 0 : 1;
 };
 
@@ -193,6 +208,8 @@ int OverlandPressureFlow::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
 void OverlandPressureFlow::UpdatePreconditioner(double t,
         Teuchos::RCP<const TreeVector> up, double h)
 {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   // VerboseObject stuff.
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
@@ -135,6 +135,8 @@ int OverlandFlow::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos:
 // Update the preconditioner at time t and u = up
 // -----------------------------------------------------------------------------
 void OverlandFlow::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   // VerboseObject stuff.
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
@@ -211,9 +213,10 @@ void OverlandFlow::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector>
 
 
 // -----------------------------------------------------------------------------
-// Default enorm that uses an abs and rel tolerance to monitor convergence.
+// This rank's contribution to the enorm, which uses an abs and rel tolerance
+// to monitor convergence.
 // -----------------------------------------------------------------------------
-double OverlandFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
+double OverlandFlow::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
         Teuchos::RCP<const TreeVector> res) {
   const Epetra_MultiVector& pd = *S_next_->GetFieldData(key_)
       ->ViewComponent("cell",true);
@@ -256,13 +259,12 @@ double OverlandFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
       const Epetra_MultiVector& kr_f = *S_next_->GetFieldData(Keys::getDerivKey(Keys::getKey(domain_,"upwind_overland_conductivity"), key_))
         ->ViewComponent("face",false);
 
+      UpdateErrorNormFaceCells_();
       for (unsigned int f=0; f!=nfaces; ++f) {
-        AmanziMesh::Entity_ID_List cells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
-        double cv_min = cells.size() == 1 ? cv[0][cells[0]]
-            : std::min(cv[0][cells[0]],cv[0][cells[1]]);
-        double conserved_min = cells.size() == 1 ? pd[0][cells[0]] * cv[0][cells[0]]
-            : std::min(pd[0][cells[0]]*cv[0][cells[0]], pd[0][cells[1]]*cv[0][cells[1]]);
+        AmanziMesh::Entity_ID c0 = enorm_face_cells_[2*f];
+        AmanziMesh::Entity_ID c1 = enorm_face_cells_[2*f+1];
+        double cv_min = std::min(cv[0][c0], cv[0][c1]);
+        double conserved_min = std::min(pd[0][c0]*cv[0][c0], pd[0][c1]*cv[0][c1]);
       
         double enorm_f = fluxtol_ * h * std::abs(dvec_v[0][f]) 
             / (atol_*cv_min + rtol_*std::abs(conserved_min));
@@ -298,9 +300,6 @@ double OverlandFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     enorm_val = std::max(enorm_val, enorm_comp);
   }
 
-  double enorm_val_l = enorm_val;
-  int ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-  AMANZI_ASSERT(!ierr);
   return enorm_val;
 };
 
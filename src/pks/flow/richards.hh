@@ -84,6 +84,24 @@ Solves Richards equation:
       - `"arithmetic mean`" Face value is the mean of the neighboring cells.
         Not a good method.
 
+   * `"flux direction method`" ``[string]`` **diffusion operator** For
+      `"upwind with Darcy flux`", how the flux direction used for upwinding is
+      calculated.  One of:
+
+      - `"diffusion operator`" Assemble the diffusion operator without rel
+        perm and calculate its flux.
+      - `"two-point estimate`" Estimate the flux with a two-point flux
+        approximation from cell pressures and densities, without assembling
+        the operator.  This is cheaper, and matches the operator's direction
+        on K-orthogonal meshes.
+
+   * `"flux direction fallback tolerance`" ``[double]`` **0** For the
+      `"two-point estimate`", faces whose estimated flux magnitude is below
+      this are recalculated using the diffusion operator.  The estimate is a
+      transmissibility, K A / d [m^3], times a potential difference [Pa], so
+      this is in [m^3 Pa]; on Neumann faces it is the boundary flux times the
+      face area.  By default the operator is never used.
+
    Globalization and other process-based hacks:
 
    * `"modify predictor with consistent faces`" ``[bool]`` **false** In a
@@ -208,6 +226,7 @@ Solves Richards equation:
 #include "wrm_partition.hh"
 #include "BoundaryFunction.hh"
 #include "upwinding.hh"
+#include "flux_direction_tpfa.hh"
 
 #include "PDE_DiffusionFactory.hh"
 #include "PDE_Accumulation.hh"
@@ -338,6 +357,8 @@ protected:
   bool explicit_source_;
   std::string clobber_policy_;
   bool clobber_boundary_flux_dir_;
+  bool flux_dir_two_point_;
+  double flux_dir_fallback_tol_;
 
   // coupling terms
   bool coupled_to_surface_via_head_; // surface-subsurface Dirichlet coupler
@@ -362,6 +383,8 @@ protected:
   Teuchos::RCP<Operators::PDE_DiffusionWithGravity> matrix_diff_;
   Teuchos::RCP<Operators::PDE_DiffusionWithGravity> preconditioner_diff_;
   Teuchos::RCP<Operators::PDE_DiffusionWithGravity> face_matrix_diff_;
+  Operators::FluxDirectionTPFA flux_dir_tpfa_;
+  Teuchos::RCP<CompositeVector> flux_dir_fallback_;
   Teuchos::RCP<Operators::PDE_Accumulation> preconditioner_acc_;
 
   // flag to do jacobian and therefore coef derivs
@@ -61,6 +61,8 @@ Richards::Richards(Teuchos::ParameterList& pk_tree,
     upwind_from_prev_flux_(false),
     dynamic_mesh_(false),
     clobber_boundary_flux_dir_(false),
+    flux_dir_two_point_(false),
+    flux_dir_fallback_tol_(0.),
     vapor_diffusion_(false),
     perm_scale_(1.),
     jacobian_(false),
@@ -198,6 +200,16 @@ void Richards::SetupRichardsFlow_(const Teuchos::Ptr<State>& S)
     Exceptions::amanzi_throw(message);
   }
 
+  std::string flux_dir_method = plist_->get<std::string>("flux direction method", "diffusion operator");
+  if (flux_dir_method == "two-point estimate") {
+    flux_dir_two_point_ = true;
+    flux_dir_fallback_tol_ = plist_->get<double>("flux direction fallback tolerance", 0.);
+  } else if (flux_dir_method != "diffusion operator") {
+    Errors::Message message;
+    message << "Richards Flow PK has no flux direction method named: " << flux_dir_method;
+    Exceptions::amanzi_throw(message);
+  }
+
   // -- require the data on appropriate locations
   std::string coef_location = upwinding_->CoefficientLocation();
   if (coef_location == "upwind: face") {
@@ -829,11 +841,47 @@ bool Richards::UpdatePermeabilityData_(const Teuchos::Ptr<State>& S)
       Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(key_);
 
 
-      face_matrix_diff_->SetDensity(rho);
-      face_matrix_diff_->UpdateMatrices(Teuchos::null, pres.ptr());
-      //if (!pres->HasComponent("face"))
-      face_matrix_diff_->ApplyBCs(true, true, true);
-      face_matrix_diff_->UpdateFlux(pres.ptr(), flux_dir.ptr());
+      if (flux_dir_two_point_) {
+        if (!flux_dir_tpfa_.IsSetup() || dynamic_mesh_) {
+          Teuchos::RCP<const Epetra_Vector> gvec = S->GetConstantVectorData("gravity");
+          AmanziGeometry::Point g(3);
+          g[0] = (*gvec)[0]; g[1] = (*gvec)[1]; g[2] = (*gvec)[2];
+          flux_dir_tpfa_.Setup(*mesh_, *K_, g);
+        }
+
+        pres->ScatterMasterToGhosted("cell");
+        rho->ScatterMasterToGhosted("cell");
+        Epetra_MultiVector& flux_dir_f = *flux_dir->ViewComponent("face",false);
+        std::vector<int> near_zero;
+        int n_near_zero = flux_dir_tpfa_.Compute(*pres->ViewComponent("cell",true),
+                *rho->ViewComponent("cell",true), bc_markers(), bc_values(),
+                flux_dir_fallback_tol_, flux_dir_f, &near_zero);
+
+        // recalculate faces near zero flux with the diffusion operator
+        if (flux_dir_fallback_tol_ > 0.) {
+          int n_near_zero_global = 0;
+          mesh_->get_comm()->SumAll(&n_near_zero, &n_near_zero_global, 1);
+          if (n_near_zero_global > 0) {
+            if (flux_dir_fallback_ == Teuchos::null)
+              flux_dir_fallback_ = Teuchos::rcp(new CompositeVector(*flux_dir));
+
+            face_matrix_diff_->SetDensity(rho);
+            face_matrix_diff_->UpdateMatrices(Teuchos::null, pres.ptr());
+            face_matrix_diff_->ApplyBCs(true, true, true);
+            face_matrix_diff_->UpdateFlux(pres.ptr(), flux_dir_fallback_.ptr());
+
+            const Epetra_MultiVector& fallback_f = *flux_dir_fallback_->ViewComponent("face",false);
+            for (int f : near_zero) flux_dir_f[0][f] = fallback_f[0][f];
+          }
+        }
+
+      } else {
+        face_matrix_diff_->SetDensity(rho);
+        face_matrix_diff_->UpdateMatrices(Teuchos::null, pres.ptr());
+        //if (!pres->HasComponent("face"))
+        face_matrix_diff_->ApplyBCs(true, true, true);
+        face_matrix_diff_->UpdateFlux(pres.ptr(), flux_dir.ptr());
+      }
 
       if (clobber_boundary_flux_dir_) {
         Epetra_MultiVector& flux_dir_f = *flux_dir->ViewComponent("face",false);
@@ -881,10 +929,9 @@ bool Richards::UpdatePermeabilityData_(const Teuchos::Ptr<State>& S)
       uw_rel_perm_f.Export(rel_perm_bf, vandelay, Insert);
     } else if (clobber_policy_ == "max") {
       Epetra_MultiVector& uw_rel_perm_f = *uw_rel_perm->ViewComponent("face",false);
-      const auto& fmap = mesh_->face_map(true);
-      const auto& bfmap = mesh_->exterior_face_map(true);
+      const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh_);
       for (int bf=0; bf!=rel_perm_bf.MyLength(); ++bf) {
-        auto f = fmap.LID(bfmap.GID(bf));
+        auto f = bfs.face(bf);
         if (rel_perm_bf[0][bf] > uw_rel_perm_f[0][f]) {
           uw_rel_perm_f[0][f] = rel_perm_bf[0][bf];
         }
@@ -893,17 +940,15 @@ bool Richards::UpdatePermeabilityData_(const Teuchos::Ptr<State>& S)
       // clobber only when the interior cell is unsaturated
       Epetra_MultiVector& uw_rel_perm_f = *uw_rel_perm->ViewComponent("face",false);
       const Epetra_MultiVector& pres = *S->GetFieldData(key_)->ViewComponent("cell",false);
-      const auto& fmap = mesh_->face_map(true);
-      const auto& bfmap = mesh_->exterior_face_map(true);
+      const auto& bfs = Operators::BoundaryFaceIndex::Get(*mesh_);
       for (int bf=0; bf!=rel_perm_bf.MyLength(); ++bf) {
-        auto f = fmap.LID(bfmap.GID(bf));
-        AmanziMesh::Entity_ID_List fcells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &fcells);
-        AMANZI_ASSERT(fcells.size() == 1);
-        if (pres[0][fcells[0]] < 101225.) {
+        auto f = bfs.face(bf);
+        auto c = bfs.cell(bf);
+        AMANZI_ASSERT(c >= 0);
+        if (pres[0][c] < 101225.) {
           uw_rel_perm_f[0][f] = rel_perm_bf[0][bf];
-        } else if (pres[0][fcells[0]] < 101325.) {
-          double frac = (101325. - pres[0][fcells[0]])/100.;
+        } else if (pres[0][c] < 101325.) {
+          double frac = (101325. - pres[0][c])/100.;
           uw_rel_perm_f[0][f] = rel_perm_bf[0][bf] * frac + uw_rel_perm_f[0][f] * (1-frac);
         }
       }
@@ -1162,7 +1207,7 @@ void Richards::UpdateBoundaryConditions_(const Teuchos::Ptr<State>& S, bool kr)
       markers[f] = Operators::OPERATOR_BC_DIRICHLET;
       values[f] = p_atm;
       if (i == 0)
-        std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << flux[0][f]*getBoundaryDirection(*mesh_, f) << " resulted in DIRICHLET pressure " << p_atm << std::endl;
+        std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << boundary_flux << " resulted in DIRICHLET pressure " << p_atm << std::endl;
 
     } else if (boundary_flux >= bc.second - flux_seepage_tol &&
         boundary_pressure > p_atm - seepage_tol) {
@@ -1170,7 +1215,7 @@ void Richards::UpdateBoundaryConditions_(const Teuchos::Ptr<State>& S, bool kr)
       markers[f] = Operators::OPERATOR_BC_DIRICHLET;
       values[f] = p_atm;
     if (i == 0)
-      std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << flux[0][f]*getBoundaryDirection(*mesh_, f) << " resulted in DIRICHLET pressure " << p_atm << std::endl;
+      std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << boundary_flux << " resulted in DIRICHLET pressure " << p_atm << std::endl;
 
     } else if (boundary_flux < bc.second - flux_seepage_tol &&
         boundary_pressure <= p_atm + seepage_tol) {
@@ -1178,7 +1223,7 @@ void Richards::UpdateBoundaryConditions_(const Teuchos::Ptr<State>& S, bool kr)
       markers[f] = Operators::OPERATOR_BC_NEUMANN;
       values[f] = bc.second;
     if (i == 0)
-      std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << flux[0][f]*getBoundaryDirection(*mesh_, f) << " resulted in NEUMANN flux " << bc.second << std::endl;
+      std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << boundary_flux << " resulted in NEUMANN flux " << bc.second << std::endl;
 
     } else if (boundary_flux >= bc.second - flux_seepage_tol &&
         boundary_pressure <= p_atm - seepage_tol) {
@@ -1186,7 +1231,7 @@ void Richards::UpdateBoundaryConditions_(const Teuchos::Ptr<State>& S, bool kr)
       markers[f] = Operators::OPERATOR_BC_NEUMANN;
       values[f] = bc.second;
     if (i == 0)
-      std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << flux[0][f]*getBoundaryDirection(*mesh_, f) << " resulted in NEUMANN flux " << bc.second << std::endl;
+      std::cout << "BC PRESSURE ON SEEPAGE = " << boundary_pressure << " with flux " << boundary_flux << " resulted in NEUMANN flux " << bc.second << std::endl;
 
     } else {
       AMANZI_ASSERT(0);
@@ -24,6 +24,8 @@ void RichardsSteadyState::Setup(const Teuchos::Ptr<State>& S) {
 // Update the preconditioner at time t and u = up
 // -----------------------------------------------------------------------------
 void RichardsSteadyState::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   // VerboseObject stuff.
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_HIGH)) {
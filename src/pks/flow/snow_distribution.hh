@@ -102,7 +102,7 @@ public:
   virtual void UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h);
 
   // error monitor
-  virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
+  virtual double ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
                        Teuchos::RCP<const TreeVector> du);
 
   virtual bool ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
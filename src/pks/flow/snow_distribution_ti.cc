@@ -137,6 +137,8 @@ int SnowDistribution::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuc
 // Update the preconditioner at time t and u = up
 // -----------------------------------------------------------------------------
 void SnowDistribution::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   // VerboseObject stuff.
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
@@ -189,7 +191,7 @@ void SnowDistribution::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVec
   preconditioner_diff_->ApplyBCs(true, true, true);
 };
 
-double SnowDistribution::ErrorNorm(Teuchos::RCP<const TreeVector> u,
+double SnowDistribution::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
                        Teuchos::RCP<const TreeVector> du) {
   Teuchos::OSTab tab = vo_->getOSTab();
 
@@ -231,8 +233,6 @@ double SnowDistribution::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     *vo_->os() << "ENorm (cells) = " << err_c.value << "[" << err_c.gid << "] (" << infnorm_c << ")" << std::endl;
   }
 
-  double buf = enorm_cell;
-  MPI_Allreduce(&buf, &enorm_cell, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
   return enorm_cell;
 };
 
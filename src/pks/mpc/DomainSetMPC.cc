@@ -9,6 +9,11 @@ A DomainSet coupler, couples a bunch of domains of the same structure.
 
 ------------------------------------------------------------------------- */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "pk_helpers.hh"
 #include "DomainSetMPC.hh"
 
 namespace Amanzi {
@@ -20,7 +25,9 @@ DomainSetMPC::DomainSetMPC(Teuchos::ParameterList& pk_tree,
     : MPC<PK>(pk_tree, global_list, S, solution),
       PK(pk_tree, global_list, S, solution),
       subcycled_(false),
-      subcycled_target_dt_(-1.)
+      subcycled_target_dt_(-1.),
+      concurrent_(false),
+      n_threads_(1)
 {
   // grab the list of subpks
   auto subpks = this->plist_->template get<Teuchos::Array<std::string> >("PKs order");
@@ -50,6 +57,10 @@ DomainSetMPC::DomainSetMPC(Teuchos::ParameterList& pk_tree,
   }
   this->plist_->template set("PKs order", subpks);
 
+  // PKs advanced in threads must not write output
+  concurrent_ = plist_->template get<bool>("advance subdomains concurrently", false);
+  if (concurrent_) silenceDomainSetPKs(*pks_list_, ds_name_);
+
   // construct the sub-PKs on COMM_SELF
   // FIXME: This should somehow get run on the DomainSet's entries Comms, not
   // on COMM_SELF! --etc
@@ -61,6 +72,66 @@ DomainSetMPC::DomainSetMPC(Teuchos::ParameterList& pk_tree,
     subcycled_target_dt_ = plist_->template get<double>("subcycling target time step [s]");
     subcycled_min_dt_ = plist_->template get<double>("minimum subcycled time step [s]", 1.e-4);
   }
+
+  // check whether we are advancing subdomains in threads
+  if (concurrent_ && subcycled_) {
+    Errors::Message msg;
+    msg << "DomainSetMPC: \"" << name()
+        << "\" cannot both \"subcycle subdomains\" and \"advance subdomains concurrently\".";
+    Exceptions::amanzi_throw(msg);
+  }
+  if (concurrent_) {
+    n_threads_ = plist_->template get<int>("number of threads", -1);
+#ifdef _OPENMP
+    if (n_threads_ <= 0) n_threads_ = omp_get_max_threads();
+#else
+    n_threads_ = 1;
+#endif
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Setup: concurrent advance requires thread-safe libraries.
+// -----------------------------------------------------------------------------
+void DomainSetMPC::Setup(const Teuchos::Ptr<State>& S)
+{
+  MPC<PK>::Setup(S);
+
+  if (concurrent_) {
+    std::string reason = getThreadedAdvanceError();
+    if (!reason.empty()) {
+      Errors::Message msg;
+      msg << "DomainSetMPC: \"" << name()
+          << "\" cannot \"advance subdomains concurrently\": " << reason;
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Initialize: concurrently advanced subdomains must not share evaluators.
+// -----------------------------------------------------------------------------
+void DomainSetMPC::Initialize(const Teuchos::Ptr<State>& S)
+{
+  MPC<PK>::Initialize(S);
+
+  if (concurrent_) {
+    // all subdomains are constructed from the same spec, so the first is
+    // representative
+    const auto& ds = *S->GetDomainSet(ds_name_);
+    if (ds.begin() != ds.end()) {
+      std::string dependency = getSubdomainExternalDependency(S, *ds.begin());
+      if (!dependency.empty()) {
+        Errors::Message msg;
+        msg << "DomainSetMPC: \"" << name()
+            << "\" cannot \"advance subdomains concurrently\", as subdomains share evaluators: "
+            << dependency;
+        Exceptions::amanzi_throw(msg);
+      }
+    }
+  }
 }
 
 
@@ -114,11 +185,15 @@ bool
 DomainSetMPC::AdvanceStep_Standard_(double t_old, double t_new, bool reinit)
 {
   int nfailed = 0;
-  for (const auto& pk : sub_pks_) {
-    bool fail = pk->AdvanceStep(t_old, t_new, reinit);
-    if (fail) {
-      nfailed++;
-      break;
+  if (concurrent_) {
+    nfailed = AdvanceStep_Concurrent_(t_old, t_new, reinit);
+  } else {
+    for (const auto& pk : sub_pks_) {
+      bool fail = pk->AdvanceStep(t_old, t_new, reinit);
+      if (fail) {
+        nfailed++;
+        break;
+      }
     }
   }
   int nfailed_global(0);
@@ -128,6 +203,45 @@ DomainSetMPC::AdvanceStep_Standard_(double t_old, double t_new, bool reinit)
 }
 
 
+//-------------------------------------------------------------------------------------
+// Advance all sub-PKs in threads.
+//
+// Unlike the serial loop, this cannot stop at the first failure, so every
+// subdomain attempts the step.  Exceptions are caught per subdomain and the
+// first one, in PK order, is rethrown once all threads are done.
+//-------------------------------------------------------------------------------------
+int
+DomainSetMPC::AdvanceStep_Concurrent_(double t_old, double t_new, bool reinit)
+{
+  int n_pks = sub_pks_.size();
+  std::vector<int> failed(n_pks, 0);
+  std::vector<std::string> errors(n_pks);
+
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads_)
+  for (int i=0; i<n_pks; ++i) {
+    try {
+      failed[i] = sub_pks_[i]->AdvanceStep(t_old, t_new, reinit) ? 1 : 0;
+    } catch (const std::exception& e) {
+      errors[i] = e.what();
+      failed[i] = 1;
+    }
+  }
+
+  for (int i=0; i!=n_pks; ++i) {
+    if (!errors[i].empty()) {
+      Errors::Message msg;
+      msg << "DomainSetMPC: subdomain PK \"" << sub_pks_[i]->name()
+          << "\" threw: " << errors[i];
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+
+  int nfailed = 0;
+  for (int i=0; i!=n_pks; ++i) nfailed += failed[i];
+  return nfailed;
+}
+
+
 //-------------------------------------------------------------------------------------
 // Advance the timestep through subcyling
 //-------------------------------------------------------------------------------------
@@ -31,6 +31,22 @@ one fails, all take a smaller timestep) and subcycled timestepping.
 
    END
 
+   * `"advance subdomains concurrently`" ``[bool]`` **false** If true, and
+     ATS was built with OpenMP, advance the subdomain PKs on this rank in
+     parallel threads.  Failures are summed over all subdomains after the
+     fact, so the result does not depend on thread scheduling.  This requires
+     Trilinos built with thread-safe reference counting, an MPI whose default
+     thread level is `"MPI_THREAD_MULTIPLE`" (e.g. MPICH's
+     `"MPIR_CVAR_DEFAULT_THREAD_LEVEL`"), and that subdomain PKs do not share
+     evaluators, i.e. that no subdomain field depends upon a field outside of
+     its subdomain; each is checked, and it is an error if not met.  The
+     subdomain PKs write no output, and ATS's timers skip their work, as
+     neither is thread safe.  Not supported in combination with subcycling, as
+     subcycled subdomains each set the (shared) State's time.
+
+   * `"number of threads`" ``[int]`` **-1** Number of threads used to advance
+     subdomains concurrently.  If <= 0, the OpenMP default is used.
+
    INCLUDES:
    - ``[mpc-spec]`` *Is an* MPC_.
 
@@ -54,6 +70,8 @@ class DomainSetMPC : public MPC<PK> {
   virtual ~DomainSetMPC() = default;
 
   // PK methods
+  virtual void Setup(const Teuchos::Ptr<State>& S) override;
+  virtual void Initialize(const Teuchos::Ptr<State>& S) override;
   virtual double get_dt() override;
   virtual void set_dt(double dt) override;
   virtual bool AdvanceStep(double t_old, double t_new, bool reinit) override;
@@ -65,12 +83,17 @@ class DomainSetMPC : public MPC<PK> {
   bool AdvanceStep_Standard_(double t_old, double t_new, bool reinit);
   bool AdvanceStep_Subcycled_(double t_old, double t_new, bool reinit);
 
+  // advances all sub-PKs, returning the number that failed
+  int AdvanceStep_Concurrent_(double t_old, double t_new, bool reinit);
+
  protected:
   std::string pks_set_;
   bool subcycled_;
   double subcycled_target_dt_;
   double subcycled_min_dt_;
   double cycle_dt_;
+  bool concurrent_;
+  int n_threads_;
   Key ds_name_;
 
  private:
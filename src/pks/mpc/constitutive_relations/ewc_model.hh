@@ -35,6 +35,19 @@ class EWCModel {
   virtual int InverseEvaluateEnergy(double energy, double p, double& T) = 0;
 
   virtual int EvaluateSaturations(double T, double p, double& s_gas, double& s_liq, double& s_ice) = 0;
+
+  // Newton iterations taken by the last (Inverse)Evaluate call.
+  virtual int NumIterations() const { return 0; }
+
+  // A copy holding the current cell's parameters, so that cells updated in
+  // turn may then be inverse evaluated concurrently.  Models which cannot be
+  // copied return null.
+  virtual Teuchos::RCP<EWCModel> Clone() const { return Teuchos::null; }
+
+  // Keep diagnostics, rather than writing them to std::cout, until taken by
+  // the caller, e.g. for clones solved on threads.
+  virtual void BufferDiagnostics() {}
+  virtual std::string TakeDiagnostics() { return std::string(); }
 };
 
 
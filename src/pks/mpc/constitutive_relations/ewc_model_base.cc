@@ -22,6 +22,7 @@ namespace Amanzi {
 int EWCModelBase::Evaluate(double T, double p,
         double& energy, double& wc) {
   AmanziGeometry::Point res(2);
+  num_its_ = 0;
   int ierr = EvaluateEnergyAndWaterContent_(T,p,res);
   energy = res[0];
   wc = res[1];
@@ -29,6 +30,16 @@ int EWCModelBase::Evaluate(double T, double p,
 };
 
 
+// ----------------------------------------------------------------------
+// Diagnostics kept since the last call, if buffered.
+// ----------------------------------------------------------------------
+std::string EWCModelBase::TakeDiagnostics() {
+  std::string diagnostics = diagnostics_.str();
+  diagnostics_.str(std::string());
+  return diagnostics;
+}
+
+
 /* ----------------------------------------------------------------------
 Solves a given energy and water content (at a given, fixed porosity), for
 temperature and pressure.
@@ -54,19 +65,20 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
   double tol = 1.e-6;
   double max_steps = 100;
   double stepnum = 0;
+  num_its_ = 0;
 
   // get the initial residual
   AmanziGeometry::Point res(2);
   WhetStone::Tensor jac(2,2);
   int ierr = EvaluateEnergyAndWaterContentAndJacobian_(T,p,res,jac);
   if (ierr) {
-    std::cout << "Error in evaluation: " << ierr << std::endl;
+    os_() << "Error in evaluation: " << ierr << std::endl;
     return ierr + 10;
   }
 
   if (verbose) {
-    std::cout << "Inverse Evaluating, e=" << energy << ", wc=" << wc << std::endl;
-    std::cout << "   guess T,p (res) = " << T << ", " << p << " (" << res[0] << ", " << res[1] << ")" << std::endl;
+    os_() << "Inverse Evaluating, e=" << energy << ", wc=" << wc << std::endl;
+    os_() << "   guess T,p (res) = " << T << ", " << p << " (" << res[0] << ", " << res[1] << ")" << std::endl;
   }
 
   AmanziGeometry::Point f(2);
@@ -93,11 +105,11 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
     AmanziGeometry::Point correction;
 
     if (std::abs(detJ) < 1.e-20) {
-      std::cout << " Zero determinant of Jacobian:" << std::endl;
-      std::cout << "   [" << jac(0,0) << "," << jac(0,1) << "]" << std::endl;
-      std::cout << "   [" << jac(1,0) << "," << jac(1,1) << "]" << std::endl;
-      std::cout << "  at T,p = " << x_tmp[0] << ", " << x_tmp[1] << std::endl;
-      std::cout << "  with res(e,wc) = " << res[0] << ", " << res[1] << std::endl;
+      os_() << " Zero determinant of Jacobian:" << std::endl;
+      os_() << "   [" << jac(0,0) << "," << jac(0,1) << "]" << std::endl;
+      os_() << "   [" << jac(1,0) << "," << jac(1,1) << "]" << std::endl;
+      os_() << "  at T,p = " << x_tmp[0] << ", " << x_tmp[1] << std::endl;
+      os_() << "  with res(e,wc) = " << res[0] << ", " << res[1] << std::endl;
       return 1;
     }
 
@@ -120,7 +132,7 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
     x_tmp = x - correction;
     ierr = EvaluateEnergyAndWaterContentAndJacobian_(x_tmp[0],x_tmp[1],res,jac);
     if (ierr) {
-      std::cout << "Error in evaluation: " << ierr << std::endl;
+      os_() << "Error in evaluation: " << ierr << std::endl;
       return ierr + 10;
     }
     res = res - f;
@@ -130,8 +142,8 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
     double norm_new = AmanziGeometry::norm(scaled_res);
 
     if (verbose) {
-      std::cout << "  Iter: " << stepnum;
-      std::cout << " corrected T,p (res) [norm] = " << x_tmp[0] << ", " << x_tmp[1] << " (" << res[0] << ", " << res[1] << ") ["
+      os_() << "  Iter: " << stepnum;
+      os_() << " corrected T,p (res) [norm] = " << x_tmp[0] << ", " << x_tmp[1] << " (" << res[0] << ", " << res[1] << ") ["
                 << norm_new << "]" << std::endl;
     }
 
@@ -147,7 +159,7 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
       // evaluate the damped value
       ierr = EvaluateEnergyAndWaterContent_(x_tmp[0],x_tmp[1],res);
       if (ierr) {
-        std::cout << "Error in evaluation: " << ierr << std::endl;
+        os_() << "Error in evaluation: " << ierr << std::endl;
         return ierr + 10;
       }
       res = res - f;
@@ -157,8 +169,8 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
       norm_new = AmanziGeometry::norm(scaled_res);
 
       if (verbose) {
-        std::cout << "    Damping: " << stepnum;
-        std::cout << " corrected T,p (res) [norm] = " << x_tmp[0] << ", " << x_tmp[1] << " (" << res[0] << ", " << res[1] << ") ["
+        os_() << "    Damping: " << stepnum;
+        os_() << " corrected T,p (res) [norm] = " << x_tmp[0] << ", " << x_tmp[1] << " (" << res[0] << ", " << res[1] << ") ["
                   << norm_new << "]" << std::endl;
       }
 
@@ -168,7 +180,7 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
       // must recalculate the Jacobian at the new value
       ierr = EvaluateEnergyAndWaterContentAndJacobian_(x_tmp[0],x_tmp[1],res,jac);
       if (ierr) {
-        std::cout << "Error in evaluation: " << ierr << std::endl;
+        os_() << "Error in evaluation: " << ierr << std::endl;
         return ierr + 10;
       }
       res = res - f;
@@ -183,8 +195,9 @@ int EWCModelBase::InverseEvaluate(double energy, double wc,
     converged = norm < tol || AmanziGeometry::norm(scaled_correction) < 1.e-10;
 
     stepnum++;
+    num_its_++;
     if (stepnum > max_steps && !converged) {
-      std::cout << " Nonconverged after " << max_steps << " steps with norm (tol) "
+      os_() << " Nonconverged after " << max_steps << " steps with norm (tol) "
                 << norm << " (" << tol << ")" << std::endl;
       return 2;
     }
@@ -219,19 +232,20 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
   double tol = 1.e-6;
   double max_steps = 100;
   double stepnum = 0;
+  num_its_ = 0;
 
   // get the initial residual
   AmanziGeometry::Point res(2);
   WhetStone::Tensor jac(2,2);
   int ierr = EvaluateEnergyAndWaterContentAndJacobian_(T,p,res,jac);
   if (ierr) {
-    std::cout << "Error in evaluation: " << ierr << std::endl;
+    os_() << "Error in evaluation: " << ierr << std::endl;
     return ierr + 10;
   }
 
 #if DEBUG_FLAG
-  std::cout << "Inverse Evaluating, e=" << energy << std::endl;
-  std::cout << "   guess T,p (res) = " << T << ", " << p << " (" << res[0] << ")" << std::endl;
+  os_() << "Inverse Evaluating, e=" << energy << std::endl;
+  os_() << "   guess T,p (res) = " << T << ", " << p << " (" << res[0] << ")" << std::endl;
 #endif
 
 
@@ -250,10 +264,10 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
     double correction;
 
     if (std::abs(detJ) < 1.e-20) {
-      std::cout << " Zero determinant of Jacobian:" << std::endl;
-      std::cout << "   [" << jac(0,0) << "]" << std::endl;
-      std::cout << "  at T,p = " << T_tmp2 << ", " << p << std::endl;
-      std::cout << "  with res(e) = " << f << std::endl;
+      os_() << " Zero determinant of Jacobian:" << std::endl;
+      os_() << "   [" << jac(0,0) << "]" << std::endl;
+      os_() << "  at T,p = " << T_tmp2 << ", " << p << std::endl;
+      os_() << "  with res(e) = " << f << std::endl;
       return 1;
     }
 
@@ -268,7 +282,7 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
     T_tmp2 = T_tmp - correction;
     ierr = EvaluateEnergyAndWaterContentAndJacobian_(T_tmp2,p,res,jac);
     if (ierr) {
-      std::cout << "Error in evaluation: " << ierr << std::endl;
+      os_() << "Error in evaluation: " << ierr << std::endl;
       return ierr + 10;
     }
     f = res[0] - energy;
@@ -277,8 +291,8 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
     double norm_new = std::abs(f);
 
 #if DEBUG_FLAG
-      std::cout << "  Iter: " << stepnum;
-      std::cout << " corrected T,p (res) [norm] = " << T_tmp2 << ", " << p << " (" << f << ")" << std::endl;
+      os_() << "  Iter: " << stepnum;
+      os_() << " corrected T,p (res) [norm] = " << T_tmp2 << ", " << p << " (" << f << ")" << std::endl;
 #endif
 
     double damp = 1.;
@@ -293,7 +307,7 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
       // evaluate the damped value
       ierr = EvaluateEnergyAndWaterContent_(T_tmp2,p,res);
       if (ierr) {
-        std::cout << "Error in evaluation: " << ierr << std::endl;
+        os_() << "Error in evaluation: " << ierr << std::endl;
         return ierr + 10;
       }
       f = res[0] - energy;
@@ -302,8 +316,8 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
       norm_new = std::abs(f);
 
 #if DEBUG_FLAG
-      std::cout << "    Damping: " << stepnum;
-      std::cout << " corrected T,p (res) [norm] = " << T_tmp2 << ", " << p << " (" << f << ")" << std::endl;
+      os_() << "    Damping: " << stepnum;
+      os_() << " corrected T,p (res) [norm] = " << T_tmp2 << ", " << p << " (" << f << ")" << std::endl;
 #endif
 
     }
@@ -312,7 +326,7 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
       // must recalculate the Jacobian at the new value
       ierr = EvaluateEnergyAndWaterContentAndJacobian_(T_tmp2,p,res,jac);
       if (ierr) {
-        std::cout << "Error in evaluation: " << ierr << std::endl;
+        os_() << "Error in evaluation: " << ierr << std::endl;
         return ierr + 10;
       }
       f = res[0] - energy;
@@ -324,8 +338,9 @@ int EWCModelBase::InverseEvaluateEnergy(double energy, double p,
 
     converged = norm < tol || std::abs(correction) < 1.e-3;
     stepnum++;
+    num_its_++;
     if (stepnum > max_steps && !converged) {
-      std::cout << " Nonconverged after " << max_steps << " steps with norm (tol) "
+      os_() << " Nonconverged after " << max_steps << " steps with norm (tol) "
                 << norm << " (" << tol << ")" << std::endl;
       return 2;
     }
@@ -397,5 +412,10 @@ int EWCModelBase::EvaluateEnergyAndWaterContentAndJacobian_FD_(double T, double
 }
 
 
+bool EWCModelBase::IsDegenerateJacobian_(const WhetStone::Tensor& jac) {
+  return (std::abs(jac(0,0)) <= 1.e-12 && std::abs(jac(1,0)) <= 1.e-12)
+      || (std::abs(jac(0,1)) <= 1.e-12 && std::abs(jac(1,1)) <= 1.e-12);
+}
+
 
 } // namespace
@@ -8,11 +8,18 @@ Author: Ethan Coon
 EWCModelBase provides some of the functionality of EWCModel for inverse
 evaluating.
 
+Models should override EvaluateEnergyAndWaterContentAndJacobian_() with the
+exact Jacobian, [dE/dT dE/dp; dWC/dT dWC/dp], as the default falls back on
+finite differences, costing three extra evaluations per Newton iteration.
+
 ------------------------------------------------------------------------- */
 
 #ifndef AMANZI_EWC_MODEL_BASE_HH_
 #define AMANZI_EWC_MODEL_BASE_HH_
 
+#include <iostream>
+#include <sstream>
+
 #include "Tensor.hh"
 #include "Point.hh"
 
@@ -22,12 +29,19 @@ namespace Amanzi {
 
 class EWCModelBase : public EWCModel {
  public:
-  EWCModelBase() {}
+  EWCModelBase() : num_its_(0), buffer_diagnostics_(false) {}
+  EWCModelBase(const EWCModelBase& other) :
+      num_its_(other.num_its_),
+      buffer_diagnostics_(other.buffer_diagnostics_) {}
   virtual ~EWCModelBase() = default;
   
   virtual int Evaluate(double T, double p, double& energy, double& wc);
   virtual int InverseEvaluate(double energy, double wc, double& T, double& p, bool verbose=false);
   virtual int InverseEvaluateEnergy(double energy, double p, double& T);
+  virtual int NumIterations() const { return num_its_; }
+
+  virtual void BufferDiagnostics() { buffer_diagnostics_ = true; }
+  virtual std::string TakeDiagnostics();
 
  protected:
 
@@ -39,6 +53,19 @@ class EWCModelBase : public EWCModel {
 
   int EvaluateEnergyAndWaterContentAndJacobian_FD_(double T, double p,
           AmanziGeometry::Point& result, WhetStone::Tensor& jac);
+
+  // True if a column of the Jacobian vanishes, e.g. a saturated, frozen
+  // cell, or a kink in a piecewise relation.  Exact Jacobians then fall back
+  // on the FD Jacobian, whose growing step can see past the flat region.
+  bool IsDegenerateJacobian_(const WhetStone::Tensor& jac);
+
+  // stream for diagnostics of the inverse evaluations
+  std::ostream& os_() { return buffer_diagnostics_ ? diagnostics_ : std::cout; }
+
+ protected:
+  int num_its_;
+  bool buffer_diagnostics_;
+  std::ostringstream diagnostics_;
 };
 
 } // namespace
@@ -293,4 +293,114 @@ int LiquidIceModel::EvaluateEnergyAndWaterContent_(double T, double p, AmanziGeo
   return ierr;
 }
 
+// Exact Jacobian, [dE/dT dE/dp; dWC/dT dWC/dp], by the chain rule through the
+// same sequence of relations as EvaluateEnergyAndWaterContent_().
+int LiquidIceModel::EvaluateEnergyAndWaterContentAndJacobian_(double T, double p,
+        AmanziGeometry::Point& result, WhetStone::Tensor& jac) {
+  if (T < 100.0 || T > 373.0) {
+    return 1; // invalid temperature
+  }
+  int ierr = 0;
+  try {
+    double poro, dporo_dp;
+    if (!poro_leij_) {
+      poro = poro_model_->Porosity(poro_, p, p_atm_);
+      dporo_dp = poro_model_->DPorosityDPressure(poro_, p, p_atm_);
+    } else {
+      poro = poro_leij_model_->Porosity(poro_, p, p_atm_);
+      dporo_dp = poro_leij_model_->DPorosityDPressure(poro_, p, p_atm_);
+    }
+
+    double eff_p = std::max(p_atm_, p);
+    double deff_p_dp = p > p_atm_ ? 1. : 0.;
+
+    std::vector<double> eos_param(2);
+    eos_param[0] = T;
+    eos_param[1] = eff_p;
+
+    double rho_l = liquid_eos_->MolarDensity(eos_param);
+    double drho_l_dT = liquid_eos_->DMolarDensityDT(eos_param);
+    double drho_l_dp = liquid_eos_->DMolarDensityDp(eos_param) * deff_p_dp;
+    double rho_i = ice_eos_->MolarDensity(eos_param);
+    double drho_i_dT = ice_eos_->DMolarDensityDT(eos_param);
+    double drho_i_dp = ice_eos_->DMolarDensityDp(eos_param) * deff_p_dp;
+
+    // without an ice capillary pressure, the WRM is called with T in place
+    // of pc_ice
+    double pc_i = T;
+    double dpc_i_dT = 1.;
+    double dpc_i_dp = 0.;
+    if (use_pc_ice_) {
+      if (pc_i_->IsMolarBasis()) {
+        pc_i = pc_i_->CapillaryPressure(T, rho_l);
+        double dpc_i_drho = pc_i_->DCapillaryPressureDRho(T, rho_l);
+        dpc_i_dT = pc_i_->DCapillaryPressureDT(T, rho_l) + dpc_i_drho * drho_l_dT;
+        dpc_i_dp = dpc_i_drho * drho_l_dp;
+      } else {
+        double mass_rho_l = liquid_eos_->MassDensity(eos_param);
+        pc_i = pc_i_->CapillaryPressure(T, mass_rho_l);
+        double dpc_i_drho = pc_i_->DCapillaryPressureDRho(T, mass_rho_l);
+        dpc_i_dT = pc_i_->DCapillaryPressureDT(T, mass_rho_l)
+            + dpc_i_drho * liquid_eos_->DMassDensityDT(eos_param);
+        dpc_i_dp = dpc_i_drho * liquid_eos_->DMassDensityDp(eos_param) * deff_p_dp;
+      }
+    }
+
+    double pc_l = pc_l_->CapillaryPressure(p, p_atm_);
+    double dpc_l_dp = pc_l_->DCapillaryPressureDp(p, p_atm_);
+
+    // saturations are ordered gas, liquid, ice
+    double s[3], ds_dpc_l[3], ds_dpc_i[3];
+    wrm_->saturations(pc_l, pc_i, s);
+    wrm_->dsaturations_dpc_liq(pc_l, pc_i, ds_dpc_l);
+    wrm_->dsaturations_dpc_ice(pc_l, pc_i, ds_dpc_i);
+
+    double ds_dT[3], ds_dp[3];
+    for (int k=0; k!=3; ++k) {
+      ds_dT[k] = ds_dpc_i[k] * dpc_i_dT;
+      ds_dp[k] = ds_dpc_l[k] * dpc_l_dp + ds_dpc_i[k] * dpc_i_dp;
+    }
+    const int l = 1, i = 2;
+
+    double u_l = liquid_iem_->InternalEnergy(T);
+    double du_l_dT = liquid_iem_->DInternalEnergyDT(T);
+    double u_i = ice_iem_->InternalEnergy(T);
+    double du_i_dT = ice_iem_->DInternalEnergyDT(T);
+
+    double u_rock = rock_iem_->InternalEnergy(T);
+    double du_rock_dT = rock_iem_->DInternalEnergyDT(T);
+
+    // water content
+    double wc = rho_l * s[l] + rho_i * s[i];
+    double dwc_dT = drho_l_dT * s[l] + rho_l * ds_dT[l]
+        + drho_i_dT * s[i] + rho_i * ds_dT[i];
+    double dwc_dp = drho_l_dp * s[l] + rho_l * ds_dp[l]
+        + drho_i_dp * s[i] + rho_i * ds_dp[i];
+
+    result[1] = poro * wc;
+    jac(1,0) = poro * dwc_dT;
+    jac(1,1) = dporo_dp * wc + poro * dwc_dp;
+
+    // energy
+    double e = u_l * rho_l * s[l] + u_i * rho_i * s[i];
+    double de_dT = du_l_dT * rho_l * s[l] + u_l * (drho_l_dT * s[l] + rho_l * ds_dT[l])
+        + du_i_dT * rho_i * s[i] + u_i * (drho_i_dT * s[i] + rho_i * ds_dT[i]);
+    double de_dp = u_l * (drho_l_dp * s[l] + rho_l * ds_dp[l])
+        + u_i * (drho_i_dp * s[i] + rho_i * ds_dp[i]);
+
+    result[0] = poro * e + (1.0 - poro_) * (rho_rock_ * u_rock);
+    jac(0,0) = poro * de_dT + (1.0 - poro_) * (rho_rock_ * du_rock_dT);
+    jac(0,1) = dporo_dp * e + poro * de_dp;
+  } catch (const Exceptions::Amanzi_exception& e) {
+    if (e.what() == std::string("Cut time step")) {
+      ierr = 1;
+    }
+  }
+
+  if (!ierr && IsDegenerateJacobian_(jac)) {
+    return EvaluateEnergyAndWaterContentAndJacobian_FD_(T, p, result, jac);
+  }
+  return ierr;
+}
+
 }
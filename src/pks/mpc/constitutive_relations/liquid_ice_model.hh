@@ -39,6 +39,9 @@ class LiquidIceModel : public EWCModelBase {
   virtual void InitializeModel(const Teuchos::Ptr<State>& S,
                                Teuchos::ParameterList& plist);
   virtual void UpdateModel(const Teuchos::Ptr<State>& S, int c);
+  virtual Teuchos::RCP<EWCModel> Clone() const {
+    return Teuchos::rcp(new LiquidIceModel(*this));
+  }
   virtual bool Freezing(double T, double p);
   virtual int EvaluateSaturations(double T, double p,
                                   double& s_gas, double& s_liq, double& s_ice);
@@ -49,6 +52,9 @@ class LiquidIceModel : public EWCModelBase {
   int EvaluateEnergyAndWaterContent_(double T, double p,
           AmanziGeometry::Point& result);
 
+  int EvaluateEnergyAndWaterContentAndJacobian_(double T, double p,
+          AmanziGeometry::Point& result, WhetStone::Tensor& jac);
+
  protected:
   Teuchos::RCP<Flow::WRMPermafrostModelPartition> wrms_;
   Teuchos::RCP<Flow::WRMPermafrostModel> wrm_;
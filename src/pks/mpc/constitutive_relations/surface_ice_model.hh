@@ -39,6 +39,9 @@ class SurfaceIceModel : public EWCModelBase {
   SurfaceIceModel() {}
   virtual void InitializeModel(const Teuchos::Ptr<State>& S, Teuchos::ParameterList& plist);
   virtual void UpdateModel(const Teuchos::Ptr<State>& S, int c);
+  virtual Teuchos::RCP<EWCModel> Clone() const {
+    return Teuchos::rcp(new SurfaceIceModel(*this));
+  }
 
   virtual bool Freezing(double T, double p) { return T < 273.15; }
   virtual int EvaluateSaturations(double T, double p, double& s_gas, double& s_liq, double& s_ice) {
@@ -52,6 +55,9 @@ class SurfaceIceModel : public EWCModelBase {
   int EvaluateEnergyAndWaterContent_(double T, double p,
           AmanziGeometry::Point& result);
 
+  int EvaluateEnergyAndWaterContentAndJacobian_(double T, double p,
+          AmanziGeometry::Point& result, WhetStone::Tensor& jac);
+
  protected:
   Teuchos::RCP<Flow::IcyHeightModel> pd_;
   Teuchos::RCP<Flow::UnfrozenFractionModel> uf_;
@@ -105,6 +105,8 @@ void MPCCoupledCells::Setup(const Teuchos::Ptr<State>& S) {
 // updates the preconditioner
 void MPCCoupledCells::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up,
         double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   StrongMPC<PK_PhysicalBDF_Default>::UpdatePreconditioner(t,up,h);
 
   if (dA_dy2_ != Teuchos::null &&
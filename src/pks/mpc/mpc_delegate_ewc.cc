@@ -8,7 +8,14 @@ Author: Ethan Coon
 Interface for EWC, a helper class that does projections and preconditioners in
 energy/water-content space instead of temperature/pressure space.
 ------------------------------------------------------------------------- */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <exception>
+
 #include "FieldEvaluator.hh"
+#include "pk_helpers.hh"
 #include "ewc_model.hh"
 #include "mpc_delegate_ewc.hh"
 
@@ -20,7 +27,10 @@ namespace Amanzi {
 // Constructor
 // -----------------------------------------------------------------------------
 MPCDelegateEWC::MPCDelegateEWC(Teuchos::ParameterList& plist) :
-    plist_(Teuchos::rcpFromRef(plist)) {
+    plist_(Teuchos::rcpFromRef(plist)),
+    n_threads_(1),
+    n_ewc_cells_total_(0),
+    n_ewc_its_total_(0) {
   // set up the VerboseObject
   std::string name = plist_->get<std::string>("PK name")+std::string(" EWC");
   vo_ = Teuchos::rcp(new VerboseObject(name, *plist_));
@@ -96,6 +106,9 @@ void MPCDelegateEWC::setup(const Teuchos::Ptr<State>& S) {
       cusp_size_T_thawing_ = plist_->get<double>("freeze-thaw cusp width (thawing) [K]", 0.);
     }
   }
+
+  n_threads_ = plist_->get<int>("number of threads", 1);
+  inversion_timer_ = Teuchos::TimeMonitor::getNewCounter(name+std::string(" inversion"));
 }
 
 
@@ -236,4 +249,103 @@ void MPCDelegateEWC::update_precon_ewc_(double t, Teuchos::RCP<const TreeVector>
   }
 }
 
+
+// -----------------------------------------------------------------------------
+// Queue an inversion of the model, currently updated for cell c.
+// -----------------------------------------------------------------------------
+void MPCDelegateEWC::queue_inversion_(int c, int branch, double e, double wc,
+        double T, double p, bool verbose) {
+  EWCInversion inv;
+  inv.c = c;
+  inv.branch = branch;
+  inv.e = e;
+  inv.wc = wc;
+  inv.T = T;
+  inv.p = p;
+  inv.verbose = verbose;
+  inv.ierr = 0;
+  inv.its = 0;
+
+  // Threads each need their own copy of the model, as it holds the cell's
+  // parameters.  Verbose inversions are solved in cell order.
+#ifdef _OPENMP
+  if (n_threads_ != 1 && !verbose) inv.model = model_->Clone();
+  if (inv.model != Teuchos::null) inv.model->BufferDiagnostics();
+#endif
+
+  if (inv.model == Teuchos::null) {
+    auto monitor = startTimer(*inversion_timer_);
+    inv.ierr = model_->InverseEvaluate(e, wc, inv.T, inv.p, verbose);
+    inv.its = model_->NumIterations();
+  }
+  inversions_.push_back(inv);
+}
+
+
+// -----------------------------------------------------------------------------
+// Solve the queued inversions, which are independent, in parallel.
+//
+// Exceptions may not leave a threaded region, so they are caught per
+// inversion and the first, in cell order, is rethrown after it.  Likewise,
+// the copies' diagnostics are written after it.
+// -----------------------------------------------------------------------------
+void MPCDelegateEWC::solve_inversions_(const std::string& name) {
+  int n_inv = inversions_.size();
+  std::vector<std::exception_ptr> errors(n_inv);
+  {
+    auto monitor = startTimer(*inversion_timer_);
+#ifdef _OPENMP
+    int n_threads = n_threads_ > 0 ? n_threads_ : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 16) num_threads(n_threads)
+#endif
+    for (int i=0; i<n_inv; ++i) {
+      EWCInversion& inv = inversions_[i];
+      if (inv.model != Teuchos::null) {
+        try {
+          inv.ierr = inv.model->InverseEvaluate(inv.e, inv.wc, inv.T, inv.p, inv.verbose);
+          inv.its = inv.model->NumIterations();
+          inv.diagnostics = inv.model->TakeDiagnostics();
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    }
+  }
+
+  // release the copies
+  for (auto& inv : inversions_) inv.model = Teuchos::null;
+
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+
+  if (vo_->os_OK(Teuchos::VERB_MEDIUM)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    for (const auto& inv : inversions_) {
+      if (!inv.diagnostics.empty())
+        *vo_->os() << "  " << name << ", cell " << inv.c << ":" << std::endl
+                   << inv.diagnostics;
+    }
+  }
+
+  if (vo_->getVerbLevel() >= Teuchos::VERB_HIGH) {
+    int counts[3] = { n_inv, 0, 0 };
+    for (const auto& inv : inversions_) {
+      counts[1] += inv.its;
+      if (inv.ierr) counts[2]++;
+    }
+    int counts_global[3];
+    mesh_->get_comm()->SumAll(counts, counts_global, 3);
+    n_ewc_cells_total_ += counts_global[0];
+    n_ewc_its_total_ += counts_global[1];
+
+    Teuchos::OSTab tab = vo_->getOSTab();
+    if (vo_->os_OK(Teuchos::VERB_HIGH))
+      *vo_->os() << "  " << name << ": inverted " << counts_global[0] << " cells ("
+                 << counts_global[2] << " failed) in " << counts_global[1]
+                 << " Newton iterations; " << n_ewc_cells_total_ << " cells, "
+                 << n_ewc_its_total_ << " iterations total" << std::endl;
+  }
+}
+
 } // namespace
@@ -66,6 +66,10 @@ provides the initial guess to the nonlinear solve.
       over which to assume we are close to the latent heat cliff as we get
       warmer, and begins applying the EWC algorithm in `"ewc smarter`".
         
+    * `"number of threads`" ``[int]`` **1** Number of OpenMP threads used to
+      invert the EWC model on the cells flagged for EWC.  If 0, uses the
+      OpenMP default.  Ignored if ATS is not built with OpenMP.
+
     * `"pressure key`" ``[string]`` **DOMAIN-pressure**
     * `"temperature key`" ``[string]`` **DOMAIN-temperature**
     * `"water content key`" ``[string]`` **DOMAIN-water_content**
@@ -81,6 +85,8 @@ provides the initial guess to the nonlinear solve.
 #ifndef MPC_DELEGATE_EWC_HH_
 #define MPC_DELEGATE_EWC_HH_
 
+#include "Teuchos_TimeMonitor.hpp"
+
 #include "VerboseObject.hh"
 #include "Debugger.hh"
 #include "Tensor.hh"
@@ -117,7 +123,27 @@ class MPCDelegateEWC {
 
   virtual void update_precon_ewc_(double t, Teuchos::RCP<const TreeVector> up, double h);
 
+  // Cells flagged for EWC are first gathered, with the model updated for
+  // that cell, then inverted together, then the results are applied.
+  struct EWCInversion {
+    int c;
+    int branch;                     // which transition flagged the cell
+    double e, wc;                   // target intensive energy, water content
+    double T, p;                    // initial guess, then the solution
+    bool verbose;
+    int ierr;
+    int its;
+    Teuchos::RCP<EWCModel> model;   // copy of the model, if not yet solved
+    std::string diagnostics;        // the copy's diagnostics, once solved
+  };
 
+  // Queue an inversion for cell c.  model_ must be updated for c.  Unless the
+  // inversions will be threaded, it is solved immediately.
+  void queue_inversion_(int c, int branch, double e, double wc,
+                        double T, double p, bool verbose);
+
+  // Solve all queued inversions and report the counts.
+  void solve_inversions_(const std::string& name);
 
  protected:
   Teuchos::RCP<Teuchos::ParameterList> plist_;
@@ -150,6 +176,13 @@ class MPCDelegateEWC {
   Teuchos::RCP<Epetra_MultiVector> e_prev2_;
   double time_prev2_;
 
+  // queued inversions
+  std::vector<EWCInversion> inversions_;
+  int n_threads_;
+  long n_ewc_cells_total_;
+  long n_ewc_its_total_;
+  Teuchos::RCP<Teuchos::Time> inversion_timer_;
+
   // parameters for heuristic
   double cusp_size_T_freezing_;
   double cusp_size_T_thawing_;
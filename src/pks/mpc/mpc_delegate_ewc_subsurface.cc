@@ -26,6 +26,19 @@ energy/water-content space instead of temperature/pressure space.
 namespace Amanzi {
 
 
+namespace {
+
+// which transition flagged a cell for EWC
+enum EWCBranch {
+  BRANCH_FREEZING = 0,
+  BRANCH_THAWING,
+  BRANCH_DRAINING,
+  BRANCH_WETTING
+};
+
+} // namespace
+
+
 bool MPCDelegateEWCSubsurface::modify_predictor_smart_ewc_(double h, Teuchos::RCP<TreeVector> up) {
   Teuchos::OSTab tab = vo_->getOSTab();
   // projected guesses for T and p
@@ -79,6 +92,8 @@ bool MPCDelegateEWCSubsurface::modify_predictor_smart_ewc_(double h, Teuchos::RC
   const Epetra_MultiVector& cv = *S_next_->GetFieldData(cv_key_)
       ->ViewComponent("cell",false);
 
+  // Find the cells needing EWC, queueing their inversions.
+  inversions_.clear();
   int rank = mesh_->get_comm()->MyPID();
   int ncells = wc0.MyLength();
   for (int c=0; c!=ncells; ++c) {
@@ -145,26 +160,8 @@ bool MPCDelegateEWCSubsurface::modify_predictor_smart_ewc_(double h, Teuchos::RC
 
       } else {
         // -- invert for T,p at the projected ewc
-        ierr = model_->InverseEvaluate(e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p);
+        queue_inversion_(c, BRANCH_FREEZING, e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p, false);
         ewc_completed = true;
-        if (ierr) {
-          if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "FAILED EWC PREDICTOR" << std::endl;
-          // pass, keep the T,p projections
-        } else {
-          if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-            *dcvo->os() << "     kept within the transition zone." << std::endl
-                        << "   p,T = " << p << ", " << T << std::endl;
-
-          // in the transition zone of latent heat exchange
-          if (T > 200.) {
-            temp_guess_c[0][c] = T;
-            pres_guess_c[0][c] = p;
-          } else {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "       not admissible!" << std::endl;
-          }
-        }
       }
 #if EWC_THAWING
     } else { // increasing, thawing
@@ -182,30 +179,8 @@ bool MPCDelegateEWCSubsurface::modify_predictor_smart_ewc_(double h, Teuchos::RC
 
       } else {
         // in the transition zone of latent heat exchange
-        ierr = model_->InverseEvaluate(e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p);
+        queue_inversion_(c, BRANCH_THAWING, e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p, false);
         ewc_completed = true;
-        if (ierr) {
-          if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "FAILED EWC PREDICTOR" << std::endl;
-          // pass, keep the T,p projections
-        } else {
-          if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-            *dcvo->os() << "     kept within the transition zone." << std::endl
-                        << "   p,T = " << p << ", " << T << std::endl;
-
-          // two ways to get a projected T past freezing point:
-          //  -- be on the lower branch and overshoot (ewc results in smaller dT)
-          //  -- be on the middle branch and get over the hump (ewc results in much larger dT)
-          if (T - T_prev < temp_guess_c[0][c] - T_prev) {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "     dT_ewc < dT_std, on the lower branch, using EWC" << std::endl;
-            temp_guess_c[0][c] = T;
-            pres_guess_c[0][c] = p;
-          } else {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "     dT_ewc > dT_std, on the middle branch, use std prediction" << std::endl;
-          }
-        }
       }
 #endif
     }
@@ -229,25 +204,7 @@ bool MPCDelegateEWCSubsurface::modify_predictor_smart_ewc_(double h, Teuchos::RC
 
         } else {
           // -- invert for T,p at the projected ewc
-          ierr = model_->InverseEvaluate(e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p);
-          if (ierr) {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "FAILED EWC PREDICTOR" << std::endl;
-            // pass, keep the T,p projections
-          } else {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "     kept within the transition zone." << std::endl
-                          << "   p,T = " << p << ", " << T << std::endl;
-
-            // in the transition zone of latent heat exchange
-            if (T > 200.) {
-              temp_guess_c[0][c] = T;
-              pres_guess_c[0][c] = p;
-            } else {
-              if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-                *dcvo->os() << "       not admissible!" << std::endl;
-            }
-          }
+          queue_inversion_(c, BRANCH_DRAINING, e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p, false);
         }
 
 #if EWC_INCREASING_PRESSURE
@@ -266,29 +223,7 @@ bool MPCDelegateEWCSubsurface::modify_predictor_smart_ewc_(double h, Teuchos::RC
 
         } else {
           // in the transition zone of latent heat exchange
-          ierr = model_->InverseEvaluate(e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p);
-          if (ierr) {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "FAILED EWC PREDICTOR" << std::endl;
-            // pass, keep the T,p projections
-          } else {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "     kept within the transition zone." << std::endl
-                          << "   p,T = " << p << ", " << T << std::endl;
-          
-            // two ways to get a projected p to saturated:
-            //  -- be on the lower branch and overshoot (ewc results in smaller dp)
-            //  -- be on the middle branch and get over the hump (ewc results in much larger dp)
-            if (p - p_prev < pres_guess_c[0][c] - p_prev) {
-              if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-                *dcvo->os() << "     dp_ewc < dp_std, on the lower branch, using EWC" << std::endl;
-              temp_guess_c[0][c] = T;
-              pres_guess_c[0][c] = p;
-            } else {
-              if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-                *dcvo->os() << "     dp_ewc > dp_std, on the middle branch, use std prediction" << std::endl;
-            }
-          }
+          queue_inversion_(c, BRANCH_WETTING, e2[0][c]/cv[0][c], wc2[0][c]/cv[0][c], T, p, false);
         }
 #endif
       }
@@ -296,6 +231,73 @@ bool MPCDelegateEWCSubsurface::modify_predictor_smart_ewc_(double h, Teuchos::RC
 #endif
 
   }
+
+  // Invert, then take the EWC projections where admissible.
+  solve_inversions_("EWC predictor");
+
+  for (const auto& inv : inversions_) {
+    int c = inv.c;
+    Teuchos::RCP<VerboseObject> dcvo = Teuchos::null;
+    if (vo_->os_OK(Teuchos::VERB_EXTREME))
+      dcvo = db_->GetVerboseObject(c, rank);
+    Teuchos::OSTab dctab = dcvo == Teuchos::null ? vo_->getOSTab() : dcvo->getOSTab();
+
+    if (inv.ierr) {
+      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+        *dcvo->os() << "FAILED EWC PREDICTOR: c = " << c << std::endl;
+      // pass, keep the T,p projections
+      continue;
+    }
+
+    double T = inv.T;
+    double p = inv.p;
+    if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+      *dcvo->os() << "EWC predictor: c = " << c << std::endl
+                  << "     kept within the transition zone." << std::endl
+                  << "   p,T = " << p << ", " << T << std::endl;
+
+    if (inv.branch == BRANCH_FREEZING || inv.branch == BRANCH_DRAINING) {
+      // in the transition zone of latent heat exchange
+      if (T > 200.) {
+        temp_guess_c[0][c] = T;
+        pres_guess_c[0][c] = p;
+      } else {
+        if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+          *dcvo->os() << "       not admissible!" << std::endl;
+      }
+
+    } else if (inv.branch == BRANCH_THAWING) {
+      // two ways to get a projected T past freezing point:
+      //  -- be on the lower branch and overshoot (ewc results in smaller dT)
+      //  -- be on the middle branch and get over the hump (ewc results in much larger dT)
+      double T_prev = T1[0][c];
+      if (T - T_prev < temp_guess_c[0][c] - T_prev) {
+        if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+          *dcvo->os() << "     dT_ewc < dT_std, on the lower branch, using EWC" << std::endl;
+        temp_guess_c[0][c] = T;
+        pres_guess_c[0][c] = p;
+      } else {
+        if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+          *dcvo->os() << "     dT_ewc > dT_std, on the middle branch, use std prediction" << std::endl;
+      }
+
+    } else {
+      // two ways to get a projected p to saturated:
+      //  -- be on the lower branch and overshoot (ewc results in smaller dp)
+      //  -- be on the middle branch and get over the hump (ewc results in much larger dp)
+      double p_prev = p1[0][c];
+      if (p - p_prev < pres_guess_c[0][c] - p_prev) {
+        if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+          *dcvo->os() << "     dp_ewc < dp_std, on the lower branch, using EWC" << std::endl;
+        temp_guess_c[0][c] = T;
+        pres_guess_c[0][c] = p;
+      } else {
+        if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+          *dcvo->os() << "     dp_ewc > dp_std, on the middle branch, use std prediction" << std::endl;
+      }
+    }
+  }
+  inversions_.clear();
   return true;
 }
 
@@ -331,6 +333,8 @@ void MPCDelegateEWCSubsurface::precon_ewc_(Teuchos::RCP<const TreeVector> u,
   double dT_min = 0.01;
   double dp_min = 100.;
 
+  // Find the cells needing EWC, queueing their inversions.
+  inversions_.clear();
   int rank = mesh_->get_comm()->MyPID();
   int ncells = cv.MyLength();
   for (int c=0; c!=ncells; ++c) {
@@ -392,34 +396,9 @@ void MPCDelegateEWCSubsurface::precon_ewc_(Teuchos::RCP<const TreeVector> u,
           }
 
           // -- invert for T,p at the projected ewc
-          double T(T_prev), p(p_old[0][c]);
-          int ierr = model_->InverseEvaluate(e_ewc/cv[0][c], wc_ewc/cv[0][c], T, p, verbose);
+          queue_inversion_(c, BRANCH_FREEZING, e_ewc/cv[0][c], wc_ewc/cv[0][c],
+                           T_prev, p_old[0][c], verbose);
           ewc_completed = true;
-          if (ierr) {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "FAILED EWC PRECON" << std::endl;
-            // pass, keep the T,p projections
-
-          } else {
-            double dT_ewc = T_old[0][c] - T;
-            double dp_ewc = p_old[0][c] - p;
-
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME)) {
-              *dcvo->os() << "     kept within the transition zone." << std::endl
-                          << "   p,T_ewc = " << p << ", " << T << std::endl
-                          << "   dp,dT_ewc = " << dp_ewc << ", " << dT_ewc << std::endl;
-              if (std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) {
-                *dcvo->os() << "  sufficient change" << std::endl;
-              } else {
-                *dcvo->os() << "  insufficient change, trying anyway" << std::endl;
-              }
-            }
-
-            //            if (std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) {
-              dT_std[0][c] = dT_ewc;
-              dp_std[0][c] = dp_ewc;
-              //            }
-          }
         }
 
 #if EWC_PC_THAWING
@@ -452,39 +431,9 @@ void MPCDelegateEWCSubsurface::precon_ewc_(Teuchos::RCP<const TreeVector> u,
                         << "     wc,e_ewc = " << wc_ewc << ", " << e_ewc << std::endl;
 
           // -- invert for T,p at the projected ewc
-          double T(T_prev), p(p_old[0][c]);
-          int ierr = model_->InverseEvaluate(e_ewc/cv[0][c], wc_ewc/cv[0][c], T, p);
+          queue_inversion_(c, BRANCH_THAWING, e_ewc/cv[0][c], wc_ewc/cv[0][c],
+                           T_prev, p_old[0][c], false);
           ewc_completed = true;
-
-          if (ierr) {
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-              *dcvo->os() << "FAILED EWC PRECON" << std::endl;
-            // pass, keep the T,p projections
-
-          } else {
-            double dT_ewc = T_old[0][c] - T;
-            double dp_ewc = p_old[0][c] - p;
-
-            if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME)) {
-              *dcvo->os() << "     within the transition zone." << std::endl
-                          << "   p,T_ewc = " << p << ", " << T << std::endl
-                          << "   dp,dT_ewc = " << dp_ewc << ", " << dT_ewc << std::endl;
-              if ((std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) &&
-                  (std::abs(dT_ewc) < std::abs(dT_std[0][c]))) {
-                *dcvo->os() << "  sufficient change, and decreased dT (and so on the lower branch), using EWC" << std::endl;
-              } else if ((std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min)) {
-                *dcvo->os() << "  increased dT (and so on the middle branch), using std" << std::endl;
-              } else {
-                *dcvo->os() << "  insufficient change, trying anyway" << std::endl;
-              }
-            }
-
-            //            if ((std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) &&
-            if (std::abs(dT_ewc) < std::abs(dT_std[0][c])) {
-              dT_std[0][c] = dT_ewc;
-              dp_std[0][c] = dp_ewc;
-            }
-          }
         }
 #endif
       }
@@ -527,34 +476,9 @@ void MPCDelegateEWCSubsurface::precon_ewc_(Teuchos::RCP<const TreeVector> u,
             }
 
             // -- invert for T,p at the projected ewc
-            double T(T_prev), p(p_old[0][c]);
-            int ierr = model_->InverseEvaluate(e_ewc/cv[0][c], wc_ewc/cv[0][c], T, p, verbose);
+            queue_inversion_(c, BRANCH_DRAINING, e_ewc/cv[0][c], wc_ewc/cv[0][c],
+                             T_prev, p_old[0][c], verbose);
             ewc_completed = true;
-            if (ierr) {
-              if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-                *dcvo->os() << "FAILED EWC PRECON" << std::endl;
-              // pass, keep the T,p projections
-
-            } else {
-              double dT_ewc = T_old[0][c] - T;
-              double dp_ewc = p_old[0][c] - p;
-
-              if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME)) {
-                *dcvo->os() << "     kept within the transition zone." << std::endl
-                            << "   p,T_ewc = " << p << ", " << T << std::endl
-                            << "   dp,dT_ewc = " << dp_ewc << ", " << dT_ewc << std::endl;
-                if (std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) {
-                  *dcvo->os() << "  sufficient change" << std::endl;
-                } else {
-                  *dcvo->os() << "  insufficient change, taking anyway" << std::endl;
-                }
-              }
-
-              //              if (std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) {
-                dT_std[0][c] = dT_ewc;
-                dp_std[0][c] = dp_ewc;
-                //              }
-            }
           }
 
 #if EWC_PC_INCREASING_PRESSURE          
@@ -587,40 +511,8 @@ void MPCDelegateEWCSubsurface::precon_ewc_(Teuchos::RCP<const TreeVector> u,
                           << "     wc,e_ewc = " << wc_ewc << ", " << e_ewc << std::endl;
 
             // -- invert for T,p at the projected ewc
-            double T(T_prev), p(p_old[0][c]);
-            int ierr = model_->InverseEvaluate(e_ewc/cv[0][c], wc_ewc/cv[0][c], T, p);
-
-            if (ierr) {
-              ewc_completed = true;
-              if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
-                *dcvo->os() << "FAILED EWC PRECON" << std::endl;
-              // pass, keep the T,p projections
-
-            } else {
-              double dT_ewc = T_old[0][c] - T;
-              double dp_ewc = p_old[0][c] - p;
-
-              if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME)) {
-                *dcvo->os() << "     within the transition zone." << std::endl
-                            << "   p,T_ewc = " << p << ", " << T << std::endl
-                            << "   dp,dT_ewc = " << dp_ewc << ", " << dT_ewc << std::endl;
-                if ((std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) &&
-                    (std::abs(dp_ewc) < std::abs(dp_std[0][c]))) {
-                  *dcvo->os() << "  sufficient change, and decreased dp (and so on the lower branch), using EWC" << std::endl;
-                } else if ((std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min)) {
-                  *dcvo->os() << "  increased dp (and so on the middle branch), using std" << std::endl;
-                } else {
-                  *dcvo->os() << "  insufficient change, taking anyway" << std::endl;
-                }
-              }
-
-              //              if ((std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min) &&
-              if (std::abs(dp_ewc) < std::abs(dp_std[0][c])) {
-                ewc_completed = true;
-                dT_std[0][c] = dT_ewc;
-                dp_std[0][c] = dp_ewc;
-              }
-            }
+            queue_inversion_(c, BRANCH_WETTING, e_ewc/cv[0][c], wc_ewc/cv[0][c],
+                             T_prev, p_old[0][c], false);
           }
 #endif          
         }
@@ -628,6 +520,79 @@ void MPCDelegateEWCSubsurface::precon_ewc_(Teuchos::RCP<const TreeVector> u,
 #endif
     }
   }
+
+  // Invert, then take the EWC corrections where accepted.
+  solve_inversions_("EWC precon");
+
+  for (const auto& inv : inversions_) {
+    int c = inv.c;
+    Teuchos::RCP<VerboseObject> dcvo = Teuchos::null;
+    if (vo_->os_OK(Teuchos::VERB_EXTREME))
+      dcvo = db_->GetVerboseObject(c, rank);
+    Teuchos::OSTab dctab = dcvo == Teuchos::null ? vo_->getOSTab() : dcvo->getOSTab();
+
+    if (inv.ierr) {
+      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+        *dcvo->os() << "FAILED EWC PRECON: c = " << c << std::endl;
+      // pass, keep the T,p projections
+      continue;
+    }
+
+    double dT_ewc = T_old[0][c] - inv.T;
+    double dp_ewc = p_old[0][c] - inv.p;
+    bool sufficient = std::abs(dT_ewc) > dT_min || std::abs(dp_ewc) > dp_min;
+
+    if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+      *dcvo->os() << "EWC precon: c = " << c << std::endl
+                  << "     within the transition zone." << std::endl
+                  << "   p,T_ewc = " << inv.p << ", " << inv.T << std::endl
+                  << "   dp,dT_ewc = " << dp_ewc << ", " << dT_ewc << std::endl;
+
+    if (inv.branch == BRANCH_FREEZING || inv.branch == BRANCH_DRAINING) {
+      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME)) {
+        if (sufficient) {
+          *dcvo->os() << "  sufficient change" << std::endl;
+        } else {
+          *dcvo->os() << "  insufficient change, taking anyway" << std::endl;
+        }
+      }
+      dT_std[0][c] = dT_ewc;
+      dp_std[0][c] = dp_ewc;
+
+    } else if (inv.branch == BRANCH_THAWING) {
+      bool decreased = std::abs(dT_ewc) < std::abs(dT_std[0][c]);
+      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME)) {
+        if (sufficient && decreased) {
+          *dcvo->os() << "  sufficient change, and decreased dT (and so on the lower branch), using EWC" << std::endl;
+        } else if (sufficient) {
+          *dcvo->os() << "  increased dT (and so on the middle branch), using std" << std::endl;
+        } else {
+          *dcvo->os() << "  insufficient change, trying anyway" << std::endl;
+        }
+      }
+      if (decreased) {
+        dT_std[0][c] = dT_ewc;
+        dp_std[0][c] = dp_ewc;
+      }
+
+    } else {
+      bool decreased = std::abs(dp_ewc) < std::abs(dp_std[0][c]);
+      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME)) {
+        if (sufficient && decreased) {
+          *dcvo->os() << "  sufficient change, and decreased dp (and so on the lower branch), using EWC" << std::endl;
+        } else if (sufficient) {
+          *dcvo->os() << "  increased dp (and so on the middle branch), using std" << std::endl;
+        } else {
+          *dcvo->os() << "  insufficient change, taking anyway" << std::endl;
+        }
+      }
+      if (decreased) {
+        dT_std[0][c] = dT_ewc;
+        dp_std[0][c] = dp_ewc;
+      }
+    }
+  }
+  inversions_.clear();
 }
 
 } // namespace
@@ -123,11 +123,12 @@ MPCDelegateWater::ModifyCorrection_WaterSpurtDamp(double h, Teuchos::RCP<const T
   // Approach 2
   double damp = 1.;
   if (damp_the_spurt_) {
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*domain_u->Mesh());
     for (int cs=0; cs!=ncells_surf; ++cs) {
       AmanziMesh::Entity_ID f =
           surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
-      double p_old = GetDomainFaceValue(*u->SubVector(i_domain_)->Data(), f);
-      double p_Pu = GetDomainFaceValue(*Pu->SubVector(i_domain_)->Data(), f);
+      double p_old = GetDomainFaceValue(*u->SubVector(i_domain_)->Data(), f, bfs);
+      double p_Pu = GetDomainFaceValue(*Pu->SubVector(i_domain_)->Data(), f, bfs);
       double p_new = p_old - p_Pu;
       if ((p_new > patm + cap_size_) && (p_old < patm)) {
         double my_damp = ((patm + cap_size_) - p_old) / (p_new - p_old);
@@ -166,15 +167,16 @@ MPCDelegateWater::ModifyCorrection_WaterSpurtCap(double h, Teuchos::RCP<const Tr
   // Approach 3
   int n_modified = 0;
   if (cap_the_spurt_) {
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*domain_u->Mesh());
     for (int cs=0; cs!=ncells_surf; ++cs) {
       AmanziMesh::Entity_ID f = surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
 
-      double p_old = GetDomainFaceValue(*u->SubVector(i_domain_)->Data(), f);
-      double p_Pu = GetDomainFaceValue(*Pu->SubVector(i_domain_)->Data(), f);
+      double p_old = GetDomainFaceValue(*u->SubVector(i_domain_)->Data(), f, bfs);
+      double p_Pu = GetDomainFaceValue(*Pu->SubVector(i_domain_)->Data(), f, bfs);
       double p_new = p_old - p_Pu / damp;
       if ((p_new > patm + cap_size_) && (p_old < patm)) {
         double p_corrected = p_old - (patm + cap_size_);
-        SetDomainFaceValue(*domain_Pu, f, p_corrected);
+        SetDomainFaceValue(*domain_Pu, f, p_corrected, bfs);
 
         n_modified++;
         if (vo_->os_OK(Teuchos::VERB_HIGH))
@@ -370,6 +372,7 @@ MPCDelegateWater::ModifyPredictor_Heuristic(double h, const Teuchos::RCP<TreeVec
     const Epetra_MultiVector& surf_u_prev_c =
         *S_inter_->GetFieldData("surface_pressure")->ViewComponent("cell",false);
     const double& patm = *S_next_->GetScalarData("atmospheric_pressure");
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*domain_u->Mesh());
     int ncells = surf_u_c.MyLength();
     for (int c=0; c!=ncells; ++c) {
       int f = surf_mesh->entity_get_parent(AmanziMesh::CELL, c);
@@ -384,14 +387,14 @@ MPCDelegateWater::ModifyPredictor_Heuristic(double h, const Teuchos::RCP<TreeVec
             *vo_->os() << "CHANGING (first over?): p = " << surf_u_c[0][c]
                        << " to " << patm + cap_size_ << std::endl;
           surf_u_c[0][c] = patm + cap_size_;
-          SetDomainFaceValue(*domain_u, f, surf_u_c[0][c]);
+          SetDomainFaceValue(*domain_u, f, surf_u_c[0][c], bfs);
 
         } else if (pold > 0 && dp > pold) {
           if (vo_->os_OK(Teuchos::VERB_HIGH))
             *vo_->os() << "CHANGING (second over?): p = " << surf_u_c[0][c]
                        << " to " << patm + 2*pold << std::endl;
           surf_u_c[0][c] = patm + 2*pold;
-          SetDomainFaceValue(*domain_u, f, surf_u_c[0][c]);
+          SetDomainFaceValue(*domain_u, f, surf_u_c[0][c], bfs);
         }
       }
     }
@@ -426,12 +429,13 @@ MPCDelegateWater::ModifyPredictor_WaterSpurtDamp(double h,
     Teuchos::RCP<const CompositeVector> domain_pold = S_inter_->GetFieldData(key_ss);
 
     int rank = surf_mesh->get_comm()->MyPID();
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*domain_pnew->Mesh());
     double damp = 1.;
     for (unsigned int cs=0; cs!=ncells_surf; ++cs) {
       AmanziMesh::Entity_ID f =
           surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
-      double p_old = GetDomainFaceValue(*domain_pold, f);
-      double p_new = GetDomainFaceValue(*domain_pnew, f);
+      double p_old = GetDomainFaceValue(*domain_pold, f, bfs);
+      double p_new = GetDomainFaceValue(*domain_pnew, f, bfs);
       if ((p_new > patm + cap_size_) && (p_old < patm)) {
         // first over
         double my_damp = ((patm + cap_size_) - p_old) / (p_new - p_old);
@@ -470,26 +474,26 @@ MPCDelegateWater::ModifyPredictor_WaterSpurtDamp(double h,
       for (unsigned int cs=0; cs!=ncells_surf; ++cs) {
         AmanziMesh::Entity_ID f =
             surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
-        double p_old = GetDomainFaceValue(*domain_pnew, f);;
-        double p_new = GetDomainFaceValue(*domain_pnew, f);
+        double p_old = GetDomainFaceValue(*domain_pnew, f, bfs);;
+        double p_new = GetDomainFaceValue(*domain_pnew, f, bfs);
         p_new = (p_new - p_old) / damp + p_old;
         if ((p_new > patm + cap_size_) && (p_old < patm)) {
           // first over
           double new_value = patm + cap_size_;
-          SetDomainFaceValue(*domain_pnew, f, new_value);
+          SetDomainFaceValue(*domain_pnew, f, new_value, bfs);
           surf_pnew_c[0][cs] = patm + new_value;
           if (vo_->os_OK(Teuchos::VERB_HIGH))
             std::cout << "  CAPPING THE SPURT (1st over) (sc=" << surf_mesh->cell_map(false).GID(cs) << "): p_old = " << p_old << ", p_new = " << p_new << ", p_capped = " << new_value << std::endl;
         } else if ((p_old > patm) && (p_new - p_old > p_old - patm)) {
           // second over
           double new_value = patm + 2*(p_old - patm);
-          SetDomainFaceValue(*domain_pnew, f, new_value);
+          SetDomainFaceValue(*domain_pnew, f, new_value, bfs);
           surf_pnew_c[0][cs] = new_value;
 
           if (vo_->os_OK(Teuchos::VERB_HIGH))
             std::cout << "  CAPPING THE SPURT (2nd over) (sc=" << surf_mesh->cell_map(false).GID(cs) << "): p_old = " << p_old << ", p_new = " << p_new << ", p_capped = " << new_value << std::endl;
         } else {
-          surf_pnew_c[0][cs] = GetDomainFaceValue(*domain_pnew, f);
+          surf_pnew_c[0][cs] = GetDomainFaceValue(*domain_pnew, f, bfs);
         }
       }
     }
@@ -531,6 +535,7 @@ MPCDelegateWater::ModifyPredictor_TempFromSource(double h, const Teuchos::RCP<Tr
 
     Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh =
         u->SubVector(i_surf_)->Data()->Mesh();
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*domain_pnew->Mesh());
 
     for (unsigned int c=0; c!=surf_Tnew_c.MyLength(); ++c) {
       if (surf_Tnew_c[0][c] < 271.15) {
@@ -539,7 +544,7 @@ MPCDelegateWater::ModifyPredictor_TempFromSource(double h, const Teuchos::RCP<Tr
           surf_pnew_c[0][c] = 101325.1;
           AmanziMesh::Entity_ID f =
               surf_mesh->entity_get_parent(AmanziMesh::CELL, c);
-          SetDomainFaceValue(*domain_pnew, f, surf_pnew_c[0][c]);
+          SetDomainFaceValue(*domain_pnew, f, surf_pnew_c[0][c], bfs);
         }
       }
     }
@@ -12,6 +12,7 @@
 #include "surface_ice_model.hh"
 #include "energy_base.hh"
 #include "advection.hh"
+#include "pk_helpers.hh"
 
 #include "mpc_permafrost.hh"
 
@@ -398,8 +399,14 @@ int MPCPermafrost::ApplyPreconditioner(Teuchos::RCP<const TreeVector> r,
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "Precon application:" << std::endl;
 
+  // debugger output is only gathered if it will be written
+  bool surf_debug = vo_->os_OK(Teuchos::VERB_HIGH) &&
+    isDebuggerActive(*surf_db_, *surf_mesh_, surf_flow_pk_->debugger_verbosity());
+  bool domain_debug = vo_->os_OK(Teuchos::VERB_HIGH) &&
+    isDebuggerActive(*domain_db_, *domain_mesh_, domain_flow_pk_->debugger_verbosity());
+
   // write residuals
-  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+  if (surf_debug) {
     *vo_->os() << "Residuals (surface):" << std::endl;
     std::vector<std::string> vnames;
     vnames.push_back("  r_ps");
@@ -408,12 +415,15 @@ int MPCPermafrost::ApplyPreconditioner(Teuchos::RCP<const TreeVector> r,
     vecs.push_back(r->SubVector(2)->Data().ptr());
     vecs.push_back(r->SubVector(3)->Data().ptr());
     surf_db_->WriteVectors(vnames, vecs, true);
-
+  }
+  if (domain_debug) {
     *vo_->os() << "Residuals (subsurface):" << std::endl;
-    vnames[0] = "  r_p";
-    vnames[1] = "  r_T";
-    vecs[0] = r->SubVector(0)->Data().ptr();
-    vecs[1] = r->SubVector(1)->Data().ptr();
+    std::vector<std::string> vnames;
+    vnames.push_back("  r_p");
+    vnames.push_back("  r_T");
+    std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
+    vecs.push_back(r->SubVector(0)->Data().ptr());
+    vecs.push_back(r->SubVector(1)->Data().ptr());
     domain_db_->WriteVectors(vnames, vecs, true);
   }
 
@@ -446,7 +456,7 @@ int MPCPermafrost::ApplyPreconditioner(Teuchos::RCP<const TreeVector> r,
                           Pr->SubVector(3)->Data().ptr());
 
   // dump to screen
-  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+  if (surf_debug) {
     *vo_->os() << "PC * residuals (surface):" << std::endl;
     std::vector<std::string> vnames;
     vnames.push_back("  PC * r_ps");
@@ -463,6 +473,8 @@ int MPCPermafrost::ApplyPreconditioner(Teuchos::RCP<const TreeVector> r,
 void
 MPCPermafrost::UpdatePreconditioner(double t,
         Teuchos::RCP<const TreeVector> up, double h) {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   Teuchos::OSTab tab = vo_->getOSTab();
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "Precon update at t = " << t << std::endl;
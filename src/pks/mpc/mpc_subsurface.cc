@@ -483,6 +483,8 @@ bool MPCSubsurface::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> up0
 // updates the preconditioner
 void MPCSubsurface::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h)
 {
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   Teuchos::OSTab tab = vo_->getOSTab();
 
   if (precon_type_ == PRECON_NONE) {
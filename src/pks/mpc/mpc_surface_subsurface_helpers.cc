@@ -8,11 +8,12 @@ CopySurfaceToSubsurface(const CompositeVector& surf,
                         const Teuchos::Ptr<CompositeVector>& sub)
 {
   const Epetra_MultiVector& surf_c = *surf.ViewComponent("cell",false);
+  const auto& bfs = Operators::BoundaryFaceIndex::Get(*sub->Mesh());
 
   for (unsigned int sc=0; sc!=surf_c.MyLength(); ++sc) {
     AmanziMesh::Entity_ID f =
         surf.Mesh()->entity_get_parent(AmanziMesh::CELL, sc);
-    SetDomainFaceValue(*sub, f, surf_c[0][sc]);
+    SetDomainFaceValue(*sub, f, surf_c[0][sc], bfs);
   }
 }
 
@@ -22,11 +23,12 @@ CopySubsurfaceToSurface(const CompositeVector& sub,
 {
   //  const Epetra_MultiVector& sub_f = *sub.ViewComponent("face",false);
   Epetra_MultiVector& surf_c = *surf->ViewComponent("cell",false);
+  const auto& bfs = Operators::BoundaryFaceIndex::Get(*sub.Mesh());
 
   for (unsigned int sc=0; sc!=surf_c.MyLength(); ++sc) {
     AmanziMesh::Entity_ID f =
         surf->Mesh()->entity_get_parent(AmanziMesh::CELL, sc);
-    surf_c[0][sc] = GetDomainFaceValue(sub, f);
+    surf_c[0][sc] = GetDomainFaceValue(sub, f, bfs);
   }
 }
 
@@ -38,20 +40,28 @@ MergeSubsurfaceAndSurfacePressure(const CompositeVector& h_prev,
   Epetra_MultiVector& surf_p_c = *surf_p->ViewComponent("cell",false);
   const Epetra_MultiVector& h_c = *h_prev.ViewComponent("cell",false);
   double p_atm = 101325.;
+  const auto& bfs = Operators::BoundaryFaceIndex::Get(*sub_p->Mesh());
 
   for (unsigned int sc=0; sc!=surf_p_c.MyLength(); ++sc) {
     AmanziMesh::Entity_ID f =
         surf_p->Mesh()->entity_get_parent(AmanziMesh::CELL, sc);
     if (h_c[0][sc] > 0. && surf_p_c[0][sc] > p_atm) {
-      SetDomainFaceValue(*sub_p, f,  surf_p_c[0][sc]);
+      SetDomainFaceValue(*sub_p, f,  surf_p_c[0][sc], bfs);
     } else {
-      surf_p_c[0][sc] = GetDomainFaceValue(*sub_p, f);
+      surf_p_c[0][sc] = GetDomainFaceValue(*sub_p, f, bfs);
     }
   }
 }
 
 double
 GetDomainFaceValue(const CompositeVector& sub_p, int f)
+{
+  return GetDomainFaceValue(sub_p, f, Operators::BoundaryFaceIndex::Get(*sub_p.Mesh()));
+}
+
+double
+GetDomainFaceValue(const CompositeVector& sub_p, int f,
+                   const Operators::BoundaryFaceIndex& bfs)
 {
   std::string face_entity;
   if (sub_p.HasComponent("face")) {
@@ -67,7 +77,7 @@ GetDomainFaceValue(const CompositeVector& sub_p, int f)
     const Epetra_MultiVector& vec = *sub_p.ViewComponent(face_entity, false);
     return vec[0][f];;
   } else if (face_entity == "boundary_face") {
-    int bf = sub_p.Mesh()->exterior_face_map(false).LID(sub_p.Mesh()->face_map(false).GID(f));
+    int bf = bfs.boundary_face(f);
     const Epetra_MultiVector& vec = *sub_p.ViewComponent(face_entity, false);
     return vec[0][bf];
   } else {
@@ -77,6 +87,13 @@ GetDomainFaceValue(const CompositeVector& sub_p, int f)
 
 void
 SetDomainFaceValue(CompositeVector& sub_p, int f, double value)
+{
+  SetDomainFaceValue(sub_p, f, value, Operators::BoundaryFaceIndex::Get(*sub_p.Mesh()));
+}
+
+void
+SetDomainFaceValue(CompositeVector& sub_p, int f, double value,
+                   const Operators::BoundaryFaceIndex& bfs)
 {
   std::string face_entity;
   if (sub_p.HasComponent("face")) {
@@ -92,7 +109,7 @@ SetDomainFaceValue(CompositeVector& sub_p, int f, double value)
     Epetra_MultiVector& vec = *sub_p.ViewComponent(face_entity, false);
     vec[0][f] = value;
   } else if (face_entity == "boundary_face") {
-    int bf = sub_p.Mesh()->exterior_face_map(false).LID(sub_p.Mesh()->face_map(false).GID(f));
+    int bf = bfs.boundary_face(f);
     Epetra_MultiVector& vec = *sub_p.ViewComponent(face_entity, false);
     vec[0][bf] = value;
   }
@@ -2,6 +2,7 @@
 #define PKS_MPC_SURFACE_SUBSURFACE_HELPERS_HH_
 
 #include "CompositeVector.hh"
+#include "boundary_face_index.hh"
 
 namespace Amanzi {
 
@@ -23,6 +24,16 @@ GetDomainFaceValue(const CompositeVector& sub_p, int f);
 void
 SetDomainFaceValue(CompositeVector& sub_p, int f, double value);  
 
+// as above, for use in loops over faces, given the boundary face index of
+// sub_p's mesh
+double
+GetDomainFaceValue(const CompositeVector& sub_p, int f,
+                   const Operators::BoundaryFaceIndex& bfs);
+
+void
+SetDomainFaceValue(CompositeVector& sub_p, int f, double value,
+                   const Operators::BoundaryFaceIndex& bfs);
+
 
 } // namespace
 
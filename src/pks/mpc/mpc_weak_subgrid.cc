@@ -17,7 +17,13 @@
 
  */
 
+#include <algorithm>
+#include <map>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
+#include "pk_helpers.hh"
 #include "mpc_weak_subgrid.hh"
 
 
@@ -29,8 +35,78 @@ MPCWeakSubgrid::MPCWeakSubgrid(Teuchos::ParameterList& FElist,
         const Teuchos::RCP<State>& S,
         const Teuchos::RCP<TreeVector>& solution)
     : PK(FElist, plist, S, solution),
-      MPC<PK>(FElist, plist, S, solution) {
+      MPC<PK>(FElist, plist, S, solution),
+      concurrent_(false),
+      n_threads_(1) {
+  concurrent_ = plist_->get<bool>("advance subgrids concurrently", false);
   MPCWeakSubgrid::init_(S);
+
+  if (concurrent_) {
+    n_threads_ = plist_->get<int>("number of threads", -1);
+#ifdef _OPENMP
+    if (n_threads_ <= 0) n_threads_ = omp_get_max_threads();
+#else
+    n_threads_ = 1;
+#endif
+  }
+
+  retry_failed_ = plist_->get<bool>("retry failed subgrids", false);
+  retry_min_dt_ = plist_->get<double>("minimum subgrid retry time step [s]", 1.e-4);
+};
+
+
+// -----------------------------------------------------------------------------
+// Setup: concurrent advance requires thread-safe libraries.
+// -----------------------------------------------------------------------------
+void MPCWeakSubgrid::Setup(const Teuchos::Ptr<State>& S) {
+  MPC<PK>::Setup(S);
+
+  if (concurrent_) {
+    std::string reason = getThreadedAdvanceError();
+    if (!reason.empty()) {
+      Errors::Message msg;
+      msg << "MPCWeakSubgrid: \"" << name()
+          << "\" cannot \"advance subgrids concurrently\": " << reason;
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+};
+
+
+// -----------------------------------------------------------------------------
+// Initialize: concurrently advanced subgrids must not share evaluators.
+// -----------------------------------------------------------------------------
+void MPCWeakSubgrid::Initialize(const Teuchos::Ptr<State>& S) {
+  MPC<PK>::Initialize(S);
+
+  if (concurrent_ && subgrid_domains_.size() > 0) {
+    // all subgrids are constructed from the same spec, so the first is
+    // representative
+    std::string dependency = getSubdomainExternalDependency(S, subgrid_domains_[0]);
+    if (!dependency.empty()) {
+      Errors::Message msg;
+      msg << "MPCWeakSubgrid: \"" << name()
+          << "\" cannot \"advance subgrids concurrently\", as subgrids share evaluators: "
+          << dependency;
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+};
+
+
+// -----------------------------------------------------------------------------
+// Retried subgrids substep from a scratch copy of the intermediate State,
+// which is left untouched in case the step is rejected.
+// -----------------------------------------------------------------------------
+void MPCWeakSubgrid::set_states(const Teuchos::RCP<State>& S,
+        const Teuchos::RCP<State>& S_inter,
+        const Teuchos::RCP<State>& S_next) {
+  MPC<PK>::set_states(S, S_inter, S_next);
+
+  if (retry_failed_) {
+    S_scratch_ = Teuchos::rcp(new State(*S_inter));
+    *S_scratch_ = *S_inter;
+  }
 };
 
 
@@ -59,17 +135,145 @@ void MPCWeakSubgrid::set_dt( double dt) {
 
 // -----------------------------------------------------------------------------
 // Advance each sub-PK individually.
+//
+// In the serial, non-retrying case this stops at the first failure.
+// Otherwise every subgrid attempts the step (possibly in threads), and those
+// that failed are then retried one at a time, so that a single stiff subgrid
+// does not force all others to repeat the step.
 // -----------------------------------------------------------------------------
 bool MPCWeakSubgrid::AdvanceStep(double t_old, double t_new, bool reinit) {
-  bool fail = false;
-  for (MPC<PK>::SubPKList::iterator pk = sub_pks_.begin();
-       pk != sub_pks_.end(); ++pk) {
-    fail = (*pk)->AdvanceStep(t_old, t_new, reinit);
-    if (fail) {
-      return fail;
+  int n_pks = sub_pks_.size();
+
+  // A previous attempt at this step retried subgrids, restarting their time
+  // integrators within the step, but was then rejected.  Restart them at
+  // t_old.
+  for (int i=0; i!=n_pks; ++i) {
+    if (retried_[i]) sub_pks_[i]->CommitStep(t_old, t_old, S_inter_);
+  }
+  std::fill(retried_.begin(), retried_.end(), 0);
+
+  if (!concurrent_ && !retry_failed_) {
+    for (int i=0; i!=n_pks; ++i) {
+      if (sub_pks_[i]->AdvanceStep(t_old, t_new, reinit)) return true;
+    }
+    return false;
+  }
+
+  std::vector<int> failed(n_pks, 0);
+  std::vector<std::string> errors(n_pks);
+
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads_) if(concurrent_)
+  for (int i=0; i<n_pks; ++i) {
+    try {
+      failed[i] = sub_pks_[i]->AdvanceStep(t_old, t_new, reinit) ? 1 : 0;
+    } catch (const std::exception& e) {
+      errors[i] = e.what();
+      failed[i] = 1;
+    }
+  }
+
+  for (int i=0; i!=n_pks; ++i) {
+    if (!errors[i].empty()) {
+      Errors::Message msg;
+      msg << "MPCWeakSubgrid: subgrid PK \"" << sub_pks_[i]->name()
+          << "\" threw: " << errors[i];
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+
+  int nfailed = 0;
+  for (int i=0; i!=n_pks; ++i) nfailed += failed[i];
+  if (nfailed == 0) return false;
+  if (!retry_failed_) return true;
+
+  Teuchos::OSTab tab = vo_->getOSTab();
+  if (vo_->os_OK(Teuchos::VERB_MEDIUM))
+    *vo_->os() << "Retrying " << nfailed << " of " << n_pks << " subgrids." << std::endl;
+
+  double dt = *S_next_->GetScalarData("dt", "coordinator");
+  for (int i=0; i!=n_pks; ++i) {
+    if (failed[i]) RetrySubgrid_(i, t_old, t_new);
+  }
+
+  // reset the global clock that the retries moved
+  *S_next_->GetScalarData("dt", "coordinator") = dt;
+  S_next_->set_time(t_new);
+  return false;
+};
+
+
+// -----------------------------------------------------------------------------
+// Subcycle a single subgrid PK from t_old to t_new.
+//
+// Substeps start from a scratch copy of the subgrid's domains rather than
+// S_inter_, and between them the PK's time integrator is restarted, but not
+// committed.  The last substep is committed, as any other PK, in CommitStep().
+// -----------------------------------------------------------------------------
+void MPCWeakSubgrid::RetrySubgrid_(int i, double t_old, double t_new) {
+  const auto& domains = subgrid_state_domains_[i];
+  const auto& pk = sub_pks_[i];
+  if (vo_->os_OK(Teuchos::VERB_HIGH))
+    *vo_->os() << "  retrying subgrid PK \"" << pk->name() << "\"" << std::endl;
+
+  // rewind the failed attempt
+  for (const auto& domain : domains) {
+    S_next_->AssignDomain(*S_inter_, domain);
+    S_scratch_->AssignDomain(*S_inter_, domain);
+  }
+  S_scratch_->set_time(t_old);
+  pk->set_states(S_, S_scratch_, S_next_);
+
+  double t_inner = t_old;
+  double dt_inner = pk->get_dt();
+  bool done = false;
+  while (!done) {
+    if (dt_inner < retry_min_dt_) {
+      Errors::Message msg;
+      msg << "Subgrid " << subgrid_domains_[i] << " crashing timestep in retry: dt = " << dt_inner;
+      Exceptions::amanzi_throw(msg);
     }
+
+    dt_inner = std::min(dt_inner, t_new - t_inner);
+    *S_next_->GetScalarData("dt", "coordinator") = dt_inner;
+    S_next_->set_time(t_inner + dt_inner);
+    bool fail_inner = pk->AdvanceStep(t_inner, t_inner + dt_inner, false);
+    fail_inner |= !pk->ValidStep();
+
+    if (fail_inner) {
+      for (const auto& domain : domains) S_next_->AssignDomain(*S_scratch_, domain);
+      S_next_->set_time(S_scratch_->time());
+    } else if (std::abs(t_new - t_inner - dt_inner) < 1.e-10) {
+      done = true;
+    } else {
+      t_inner += dt_inner;
+      for (const auto& domain : domains) S_scratch_->AssignDomain(*S_next_, domain);
+      S_scratch_->set_time(t_inner);
+
+      // a zero-length step restarts the time integrator at t_inner
+      pk->CommitStep(t_inner, t_inner, S_scratch_);
+    }
+    dt_inner = pk->get_dt();
+    if (vo_->os_OK(Teuchos::VERB_EXTREME))
+      *vo_->os() << "    " << (fail_inner ? "failed" : "success")
+                 << ", new timestep is " << dt_inner << std::endl;
   }
-  return fail;
+
+  pk->set_states(S_, S_inter_, S_next_);
+  retried_[i] = 1;
+  retried_t_last_[i] = t_inner;
+}
+
+
+// -----------------------------------------------------------------------------
+// Retried subgrids commit only their last substep, as their time integrators
+// were restarted at its start.
+// -----------------------------------------------------------------------------
+void MPCWeakSubgrid::CommitStep(double t_old, double t_new,
+        const Teuchos::RCP<State>& S) {
+  for (int i=0; i!=sub_pks_.size(); ++i) {
+    sub_pks_[i]->CommitStep(retried_[i] ? retried_t_last_[i] : t_old, t_new, S);
+  }
+  std::fill(retried_.begin(), retried_.end(), 0);
 };
 
 
@@ -103,10 +307,32 @@ MPCWeakSubgrid::init_(const Teuchos::RCP<State>& S)
     int gid = map.GID(i);
     std::stringstream domain_name_stream;
     domain_name_stream << std::get<0>(subgrid_triple) << "_" << gid;
+    subgrid_domains_.push_back(domain_name_stream.str());
     subpks.push_back(Keys::getKey(domain_name_stream.str(), std::get<2>(subgrid_triple)));
   }
+  retried_.resize(subgrid_domains_.size(), 0);
+  retried_t_last_.resize(subgrid_domains_.size(), 0.);
+
+  // -- find each subgrid's child domains, named PREFIX_SUBGRID_DOMAIN
+  std::map<std::string, int> subgrid_index;
+  for (int i=0; i!=subgrid_domains_.size(); ++i) {
+    subgrid_index[subgrid_domains_[i]] = i;
+    subgrid_state_domains_.emplace_back(1, subgrid_domains_[i]);
+  }
+  for (State::mesh_iterator mesh=S->mesh_begin(); mesh!=S->mesh_end(); ++mesh) {
+    const std::string& mesh_name = mesh->first;
+    for (std::size_t pos = mesh_name.find('_'); pos != std::string::npos;
+         pos = mesh_name.find('_', pos+1)) {
+      auto subgrid = subgrid_index.find(mesh_name.substr(pos+1));
+      if (subgrid != subgrid_index.end()) {
+        subgrid_state_domains_[subgrid->second].push_back(mesh_name);
+        break;
+      }
+    }
+  }
 
-  // -- create the lifted PKs
+  // -- create the lifted PKs, which must not write output if advanced in threads
+  if (concurrent_) silenceDomainSetPKs(*pks_list_, std::get<0>(subgrid_triple));
   PKFactory pk_factory;
   for (auto subpk : subpks) {
     // create the solution vector
@@ -15,6 +15,35 @@
   NOTE currently this is just a weak MPC, but should be generalized as a
   mixin in the new rewrite of PKs.
 
+.. _mpc-weak-subgrid-spec:
+.. admonition:: mpc-weak-subgrid-spec
+
+   * `"parent domain`" ``[string]`` Domain whose entities each own a subgrid.
+   * `"entity kind`" ``[string]`` Kind of the parent domain's entities.
+   * `"subgrid region name`" ``[string]`` Region defining the subgrid entities.
+
+   * `"advance subgrids concurrently`" ``[bool]`` **false** If true, and ATS
+     was built with OpenMP, advance the subgrid PKs in parallel threads.  This
+     requires Trilinos built with thread-safe reference counting, an MPI
+     whose default thread level is `"MPI_THREAD_MULTIPLE`" (e.g. MPICH's
+     `"MPIR_CVAR_DEFAULT_THREAD_LEVEL`"), and that subgrid PKs do not share
+     evaluators; each is checked, and it is an error if not met.  The subgrid
+     PKs write no output, and ATS's timers skip their work, as neither is
+     thread safe.
+   * `"number of threads`" ``[int]`` **-1** Number of threads used to advance
+     subgrids concurrently.  If <= 0, the OpenMP default is used.
+
+   * `"retry failed subgrids`" ``[bool]`` **false** If true, a subgrid PK that
+     fails the step is rewound and subcycled on its own across the step, taking
+     whatever timestep that PK requests, rather than failing the step for all
+     subgrids.  Substeps work from a scratch copy of the subgrid's domains, so
+     nothing is committed until the step as a whole is accepted.
+   * `"minimum subgrid retry time step [s]`" ``[double]`` **1e-4** Errors out
+     if a retried subgrid fails below this step size.
+
+   INCLUDES:
+   - ``[mpc-spec]`` *Is an* MPC_.
+
  */
 
 #ifndef ATS_PK_MPC_WEAK_SUBGRID_HH_
@@ -33,6 +62,15 @@ class MPCWeakSubgrid : public MPC<PK> {
           const Teuchos::RCP<TreeVector>& solution);
 
   // PK methods
+  // -- check the threading options
+  virtual void Setup(const Teuchos::Ptr<State>& S);
+  virtual void Initialize(const Teuchos::Ptr<State>& S);
+
+  // -- allocates scratch State for retries
+  virtual void set_states(const Teuchos::RCP<State>& S,
+                          const Teuchos::RCP<State>& S_inter,
+                          const Teuchos::RCP<State>& S_next);
+
   // -- dt is the minimum of the sub pks
   virtual double get_dt();
 
@@ -41,10 +79,32 @@ class MPCWeakSubgrid : public MPC<PK> {
 
   virtual void set_dt(double dt);
 
-  
+  // -- commit sub pks, retried ones from the start of their last substep
+  virtual void CommitStep(double t_old, double t_new,
+                          const Teuchos::RCP<State>& S);
+
  protected:
   void init_(const Teuchos::RCP<State>& S);
 
+  // -- subcycle one subgrid PK across the step, throwing if it crashes
+  void RetrySubgrid_(int i, double t_old, double t_new);
+
+ protected:
+  std::vector<std::string> subgrid_domains_;
+
+  // each subgrid's domain and its children, e.g. surface_ and snow_
+  std::vector<std::vector<std::string> > subgrid_state_domains_;
+
+  // retried PKs and the start of their last substep
+  std::vector<int> retried_;
+  std::vector<double> retried_t_last_;
+  Teuchos::RCP<State> S_scratch_;
+
+  bool concurrent_;
+  int n_threads_;
+  bool retry_failed_;
+  double retry_min_dt_;
+
  private:
   // factory registration
   static RegisteredPKFactory<MPCWeakSubgrid> reg_;
@@ -71,6 +71,10 @@ public:
   virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
                        Teuchos::RCP<const TreeVector> du);
 
+  // -- this rank's contribution to the enorm for the coupled system
+  virtual double ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+          Teuchos::RCP<const TreeVector> du);
+
   // StrongMPC's preconditioner is, by default, just the block-diagonal
   // operator formed by placing the sub PK's preconditioners on the diagonal.
   // -- Apply preconditioner to u and returns the result in Pu.
@@ -260,11 +264,20 @@ int StrongMPC<PK_t>::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuch
 // -----------------------------------------------------------------------------
 // Compute a norm on u-du and returns the result.
 // For a Strong MPC, the enorm is just the max of the sub PKs enorms.
+//
+// The sub-PKs' local contributions are reduced together, so that the entire
+// tree below this MPC requires a single reduction, rather than one (or more)
+// per leaf.  The location of the max identifies the sub-PK it came from.
 // -----------------------------------------------------------------------------
 template<class PK_t>
 double StrongMPC<PK_t>::ErrorNorm(Teuchos::RCP<const TreeVector> u,
                         Teuchos::RCP<const TreeVector> du){
-  double norm = 0.0;
+  struct {
+    double value;
+    int loc;
+  } l_norm, norm;
+  l_norm.value = 0.0;
+  l_norm.loc = -1;
 
   // loop over sub-PKs
   for (unsigned int i=0; i!=sub_pks_.size(); ++i) {
@@ -283,8 +296,44 @@ double StrongMPC<PK_t>::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     }
 
     // norm is the max of the sub-PK norms
-    double tmp_norm = sub_pks_[i]->ErrorNorm(pk_u, pk_du);
-    norm = std::max(norm, tmp_norm);
+    double tmp_norm = sub_pks_[i]->ErrorNormLocal(pk_u, pk_du);
+    if (tmp_norm > l_norm.value || l_norm.loc < 0) {
+      l_norm.value = tmp_norm;
+      l_norm.loc = i;
+    }
+  }
+
+  Teuchos::RCP<const MpiComm_type> mpi_comm_p =
+    Teuchos::rcp_dynamic_cast<const MpiComm_type>(u->Comm());
+  int ierr = MPI_Allreduce(&l_norm, &norm, 1, MPI_DOUBLE_INT, MPI_MAXLOC, mpi_comm_p->Comm());
+  AMANZI_ASSERT(!ierr);
+
+  if (vo_->os_OK(Teuchos::VERB_HIGH) && norm.loc >= 0)
+    *vo_->os() << "ENorm = " << norm.value << " from PK " << sub_pks_[norm.loc]->name() << std::endl;
+
+  RecordErrorNorm_(norm.value);
+  return norm.value;
+};
+
+
+// -----------------------------------------------------------------------------
+// The local contribution to the enorm is the max of the sub PKs local
+// contributions.
+// -----------------------------------------------------------------------------
+template<class PK_t>
+double StrongMPC<PK_t>::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> du){
+  double norm = 0.0;
+
+  // loop over sub-PKs
+  for (unsigned int i=0; i!=sub_pks_.size(); ++i) {
+    Teuchos::RCP<const TreeVector> pk_u = u->SubVector(i);
+    Teuchos::RCP<const TreeVector> pk_du = du->SubVector(i);
+    if (pk_u == Teuchos::null || pk_du == Teuchos::null) {
+      Errors::Message message("MPC: vector structure does not match PK structure");
+      Exceptions::amanzi_throw(message);
+    }
+    norm = std::max(norm, sub_pks_[i]->ErrorNormLocal(pk_u, pk_du));
   }
   return norm;
 };
@@ -295,7 +344,8 @@ double StrongMPC<PK_t>::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 // -----------------------------------------------------------------------------
 template<class PK_t>
 void StrongMPC<PK_t>::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
-  
+  if (!PreconditionerUpdateRequired_(h)) return;
+
   Solution_to_State(*up, S_next_);
 
   // loop over sub-PKs
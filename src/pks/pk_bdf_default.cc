@@ -10,6 +10,8 @@ Default base with default implementations of methods for a PK integrated using
 BDF.
 ------------------------------------------------------------------------- */
 
+#include <cmath>
+
 #include "Teuchos_TimeMonitor.hpp"
 #include "BDF1_TI.hh"
 #include "pk_bdf_default.hh"
@@ -30,6 +32,12 @@ void PK_BDF_Default::Setup(const Teuchos::Ptr<State>& S)
   // preconditioner assembly
   assemble_preconditioner_ = plist_->get<bool>("assemble preconditioner", true);
 
+  // preconditioner reuse policy
+  precon_reuse_ = plist_->get<bool>("reuse preconditioner", false);
+  precon_reuse_contraction_ = plist_->get<double>("preconditioner reuse contraction threshold", 0.5);
+  precon_reuse_dt_tol_ = plist_->get<double>("preconditioner reuse relative dt tolerance", 0.25);
+  precon_reuse_max_age_ = plist_->get<int>("preconditioner reuse maximum age", 20);
+
   if (!plist_->get<bool>("strongly coupled PK", false)) {
     Teuchos::ParameterList& bdf_plist = plist_->sublist("time integrator");
     // -- check if continuation method
@@ -127,6 +135,12 @@ bool PK_BDF_Default::AdvanceStep(double t_old, double t_new, bool reinit)
 
   State_to_Solution(S_next_, *solution_);
 
+  // a new nonlinear solve starts
+  precon_enorm_prev_ = -1.;
+  precon_epoch_++;
+  precon_step_refresh_count_ = 0;
+  precon_step_reuse_count_ = 0;
+
   // take a bdf timestep
   double dt_solver;
   bool fail;
@@ -163,10 +177,82 @@ bool PK_BDF_Default::AdvanceStep(double t_old, double t_new, bool reinit)
     dt_ = dt_solver;
   }
 
+  if (precon_reuse_) {
+    // never retry a step with a lagged preconditioner
+    if (fail) precon_refresh_pending_ = true;
+
+    if (vo_->os_OK(Teuchos::VERB_MEDIUM))
+      *vo_->os() << "Preconditioner: " << precon_step_refresh_count_ << " updates, "
+                 << precon_step_reuse_count_ << " reuses this step ("
+                 << precon_refresh_count_ << " updates, "
+                 << precon_reuse_count_ << " reuses total)" << std::endl;
+  }
   return fail;
 };
 
 
+// -----------------------------------------------------------------------------
+// Preconditioner reuse policy.
+//
+// Is a new preconditioner needed for step size h, or may the previously
+// assembled one be applied again?  A lagged preconditioner is kept until the
+// convergence rate degrades, the step size changes, it reaches its maximum
+// age, or a step fails.
+// -----------------------------------------------------------------------------
+bool PK_BDF_Default::PreconditionerUpdateRequired_(double h)
+{
+  // only the PK that owns the time integrator lags its preconditioner, as
+  // coupled PKs are updated whenever their MPC is
+  if (!precon_reuse_ || time_stepper_ == Teuchos::null) return true;
+
+  // nested calls, i.e. a derived class calling its base class's update, get
+  // the decision already made for this iterate
+  if (precon_decided_epoch_ == precon_epoch_) return precon_decision_;
+  precon_decided_epoch_ = precon_epoch_;
+
+  bool update = precon_age_ < 0 || precon_refresh_pending_ ||
+    std::abs(h - precon_h_) > precon_reuse_dt_tol_ * precon_h_ ||
+    (precon_reuse_max_age_ > 0 && precon_age_ >= precon_reuse_max_age_);
+
+  if (update) {
+    precon_age_ = 0;
+    precon_h_ = h;
+    precon_refresh_pending_ = false;
+    precon_refresh_count_++;
+    precon_step_refresh_count_++;
+  } else {
+    precon_age_++;
+    precon_reuse_count_++;
+    precon_step_reuse_count_++;
+
+    Teuchos::OSTab tab = vo_->getOSTab();
+    if (vo_->os_OK(Teuchos::VERB_HIGH))
+      *vo_->os() << "Precon reused, age = " << precon_age_ << std::endl;
+  }
+
+  precon_decision_ = update;
+  return update;
+}
+
+
+// -----------------------------------------------------------------------------
+// Monitor the convergence rate for the preconditioner reuse policy.
+// -----------------------------------------------------------------------------
+void PK_BDF_Default::RecordErrorNorm_(double enorm)
+{
+  if (!precon_reuse_ || time_stepper_ == Teuchos::null) return;
+
+  // A lagged preconditioner which no longer contracts the error well enough
+  // is rebuilt at the next request.  A fresh one is kept regardless.
+  if (precon_age_ > 0 && precon_enorm_prev_ > 0. &&
+      enorm > precon_reuse_contraction_ * precon_enorm_prev_) {
+    precon_refresh_pending_ = true;
+  }
+  precon_enorm_prev_ = enorm;
+  precon_epoch_++;
+}
+
+
 // update the continuation parameter
 void PK_BDF_Default::UpdateContinuationParameter(double lambda)
 {
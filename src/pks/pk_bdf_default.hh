@@ -32,6 +32,25 @@ PKs.
     * `"inverse`" ``[inverse-typed-spec]`` **optional** A Preconditioner_.
       Note that this is only used if this PK is not strongly coupled to other PKs.
 
+    * `"reuse preconditioner`" ``[bool]`` **false** If true, the assembled
+      preconditioner, and its inverse (e.g. an AMG hierarchy), are kept
+      across nonlinear iterations and time steps rather than rebuilt on
+      every update request.  It is rebuilt only when one of the criteria
+      below is met, or after a failed step.  This only applies to the PK
+      that owns the time integrator; strongly coupled PKs follow their MPC.
+
+    * `"preconditioner reuse contraction threshold`" ``[double]`` **0.5**
+      A reused preconditioner is rebuilt at the next request once the ratio
+      of successive nonlinear error norms exceeds this value.
+
+    * `"preconditioner reuse relative dt tolerance`" ``[double]`` **0.25**
+      The preconditioner is rebuilt if the time step size differs from the
+      one it was built with by more than this relative amount.
+
+    * `"preconditioner reuse maximum age`" ``[int]`` **20** The maximum
+      number of update requests a preconditioner may serve before it is
+      rebuilt.  Zero means no limit.
+
     INCLUDES:
 
     - ``[pk-spec]`` This *is a* PK_.
@@ -60,7 +79,19 @@ class PK_BDF_Default : public PK_BDF {
                  const Teuchos::RCP<State>& S,
                  const Teuchos::RCP<TreeVector>& solution) :
     PK(pk_tree, glist, S, solution),
-    PK_BDF(pk_tree, glist, S, solution) {}
+    PK_BDF(pk_tree, glist, S, solution),
+    precon_reuse_(false),
+    precon_age_(-1),
+    precon_h_(0.),
+    precon_refresh_pending_(false),
+    precon_enorm_prev_(-1.),
+    precon_epoch_(0),
+    precon_decided_epoch_(-1),
+    precon_decision_(true),
+    precon_refresh_count_(0),
+    precon_reuse_count_(0),
+    precon_step_refresh_count_(0),
+    precon_step_reuse_count_(0) {}
 
   // Virtual destructor
   virtual ~PK_BDF_Default() {}
@@ -95,6 +126,15 @@ class PK_BDF_Default : public PK_BDF {
   // update the continuation parameter
   virtual void UpdateContinuationParameter(double lambda);
 
+  // -- This rank's contribution to the error norm, such that ErrorNorm() is
+  //    its max over all ranks.  PKs override this to allow couplers to
+  //    reduce the norms of all of their sub-PKs at once.  By default it is
+  //    the (already reduced) ErrorNorm().
+  virtual double ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+          Teuchos::RCP<const TreeVector> du) {
+    return ErrorNorm(u, du);
+  }
+
   // -- Check the admissibility of a solution.
   virtual bool IsAdmissible(Teuchos::RCP<const TreeVector> up) { return true; }
 
@@ -119,10 +159,38 @@ class PK_BDF_Default : public PK_BDF {
   virtual void ChangedSolution() = 0;
   virtual void ChangedSolution(const Teuchos::Ptr<State>& S) = 0;
 
+ protected:
+  // -- Preconditioner reuse policy.  PKs call this first thing in
+  //    UpdatePreconditioner(), and return immediately if it is false, in
+  //    which case the previously assembled preconditioner is applied again.
+  bool PreconditionerUpdateRequired_(double h);
+
+  // -- Records the (reduced) error norm of each nonlinear iterate, from which
+  //    the reuse policy monitors the convergence rate.
+  void RecordErrorNorm_(double enorm);
+
  protected: // data
   // preconditioner assembly control
   bool assemble_preconditioner_;
 
+  // preconditioner reuse policy
+  bool precon_reuse_;
+  double precon_reuse_contraction_;
+  double precon_reuse_dt_tol_;
+  int precon_reuse_max_age_;
+
+  int precon_age_;              // requests served since the last update, -1 if never built
+  double precon_h_;             // step size at the last update
+  bool precon_refresh_pending_;
+  double precon_enorm_prev_;    // error norm of the previous iterate, -1 at the start of a step
+  int precon_epoch_;            // incremented at each iterate and step
+  int precon_decided_epoch_;
+  bool precon_decision_;
+
+  // preconditioner reuse statistics, totals and for the current step
+  int precon_refresh_count_, precon_reuse_count_;
+  int precon_step_refresh_count_, precon_step_reuse_count_;
+
   // timestep control
   double dt_;
   Teuchos::RCP<BDF1_TI<TreeVector, TreeVectorSpace> > time_stepper_;
@@ -8,6 +8,15 @@
 */
 
 //! A set of helper functions for doing common things in PKs.
+#include <string>
+#include <vector>
+#include "mpi.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Teuchos_ConfigDefs.hpp"
 #include "pk_helpers.hh"
 
 
@@ -19,9 +28,7 @@ namespace Amanzi {
 AmanziMesh::Entity_ID
 getBoundaryFaceFace(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID bf)
 {
-  const auto& fmap = mesh.face_map(true);
-  const auto& bfmap = mesh.exterior_face_map(true);
-  return fmap.LID(bfmap.GID(bf));
+  return Operators::BoundaryFaceIndex::Get(mesh).face(bf);
 }
 
 // -----------------------------------------------------------------------------
@@ -30,9 +37,7 @@ getBoundaryFaceFace(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID bf)
 AmanziMesh::Entity_ID
 getFaceOnBoundaryBoundaryFace(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID f)
 {
-  const auto& fmap = mesh.face_map(true);
-  const auto& bfmap = mesh.exterior_face_map(true);
-  return bfmap.LID(fmap.GID(f));
+  return Operators::BoundaryFaceIndex::Get(mesh).boundary_face(f);
 }
 
 // -----------------------------------------------------------------------------
@@ -41,7 +46,13 @@ getFaceOnBoundaryBoundaryFace(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_I
 AmanziMesh::Entity_ID
 getBoundaryFaceInternalCell(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID bf)
 {
-  return getFaceOnBoundaryInternalCell(mesh, getBoundaryFaceFace(mesh, bf));
+  const auto& bfs = Operators::BoundaryFaceIndex::Get(mesh);
+  AmanziMesh::Entity_ID c = bfs.cell(bf);
+  if (c < 0) {
+    Errors::Message message("getBoundaryFaceInternalCell called with non-internal face "+std::to_string(bfs.face(bf)));
+    Exceptions::amanzi_throw(message);
+  }
+  return c;
 }
 
 
@@ -51,6 +62,11 @@ getBoundaryFaceInternalCell(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID
 AmanziMesh::Entity_ID
 getFaceOnBoundaryInternalCell(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID f)
 {
+  const auto& bfs = Operators::BoundaryFaceIndex::Get(mesh);
+  AmanziMesh::Entity_ID bf = bfs.boundary_face(f);
+  if (bf >= 0 && bfs.cell(bf) >= 0) return bfs.cell(bf);
+
+  // not a boundary face of the mesh, but may still have only one cell
   AmanziMesh::Entity_ID_List cells;
   mesh.face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
   if (cells.size() != 1) {
@@ -79,11 +95,10 @@ applyDirichletBCs(const Operators::BCs& bcs, CompositeVector& u)
   if (u.HasComponent("boundary_face")) {
     Epetra_MultiVector& u_bf = *u.ViewComponent("boundary_face", false);
     const Epetra_MultiVector& u_c = *u.ViewComponent("cell", false);
-    const Epetra_Map& vandalay_map = u.Mesh()->exterior_face_map(false);
-    const Epetra_Map& face_map = u.Mesh()->face_map(false);
+    const auto& bfs = Operators::BoundaryFaceIndex::Get(*u.Mesh());
 
     for (int bf=0; bf!=u_bf.MyLength(); ++bf) {
-      AmanziMesh::Entity_ID f = face_map.LID(vandalay_map.GID(bf));
+      AmanziMesh::Entity_ID f = bfs.face(bf);
       if (bcs.bc_model()[f] == Operators::OPERATOR_BC_DIRICHLET) {
         u_bf[0][bf] = bcs.bc_value()[f];
       }
@@ -124,6 +139,10 @@ getFaceOnBoundaryValue(AmanziMesh::Entity_ID f, const CompositeVector& u, const
 // -----------------------------------------------------------------------------
 int
 getBoundaryDirection(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID f) {
+  const auto& bfs = Operators::BoundaryFaceIndex::Get(mesh);
+  AmanziMesh::Entity_ID bf = bfs.boundary_face(f);
+  if (bf >= 0 && bfs.cell(bf) >= 0) return bfs.direction(bf);
+
   AmanziMesh::Entity_ID_List cells;
   mesh.face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
   AMANZI_ASSERT(cells.size() == 1);
@@ -135,4 +154,123 @@ getBoundaryDirection(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID f) {
 
 
 
+// -----------------------------------------------------------------------------
+// Will the debugger write anything on this rank?
+// -----------------------------------------------------------------------------
+bool
+isDebuggerActive(Debugger& db, const AmanziMesh::Mesh& mesh,
+                 Teuchos::EVerbosityLevel verbosity)
+{
+  AmanziMesh::Entity_ID_List debug_cells = db.get_cells();
+  if (debug_cells.size() == 0) return false;
+
+  const Epetra_Map& cell_map = mesh.cell_map(false);
+  int rank = mesh.get_comm()->MyPID();
+  for (auto gid : debug_cells) {
+    AmanziMesh::Entity_ID c = cell_map.LID(gid);
+    if (c < 0) continue;
+    Teuchos::RCP<VerboseObject> dcvo = db.GetVerboseObject(c, rank);
+    if (dcvo != Teuchos::null && dcvo->os_OK(verbosity)) return true;
+  }
+  return false;
+}
+
+
+// -----------------------------------------------------------------------------
+// Can PKs on this rank be advanced in concurrent threads?
+// -----------------------------------------------------------------------------
+std::string
+getThreadedAdvanceError()
+{
+  std::string reason;
+#ifndef HAVE_TEUCHOS_THREAD_SAFE
+  reason = "Trilinos was not built with Teuchos_ENABLE_THREAD_SAFE";
+#endif
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  if (provided < MPI_THREAD_MULTIPLE)
+    reason = "MPI does not provide MPI_THREAD_MULTIPLE (raise its default thread level, e.g. MPIR_CVAR_DEFAULT_THREAD_LEVEL for MPICH)";
+  return reason;
+}
+
+
+// -----------------------------------------------------------------------------
+// Does a subdomain of a domain set depend upon fields outside of it?
+// -----------------------------------------------------------------------------
+std::string
+getSubdomainExternalDependency(const Teuchos::Ptr<State>& S, const std::string& subdomain)
+{
+  // the index of this subdomain, shared by all its child domains (e.g. the
+  // surface of a column)
+  KeyTriple triple;
+  Keys::splitDomainSet(Keys::getKey(subdomain, "key"), triple);
+  const std::string& index = std::get<1>(triple);
+
+  std::vector<Key> inside, outside;
+  for (auto f=S->field_begin(); f!=S->field_end(); ++f) {
+    KeyTriple f_triple;
+    if (Keys::splitDomainSet(f->first, f_triple) && std::get<1>(f_triple) == index) {
+      if (S->HasFieldEvaluator(f->first)) inside.push_back(f->first);
+    } else {
+      outside.push_back(f->first);
+    }
+  }
+
+  // Evaluators only answer whether a given field is among their (recursive)
+  // dependencies, so each evaluator checked is one walk of its dependency
+  // graph per outside field.  Only the roots of the subdomain's graph, those
+  // no other evaluator inside depends upon, need be checked, as all others
+  // are among their dependencies.
+  std::vector<Key> roots;
+  for (const auto& key : inside) {
+    bool is_root = true;
+    for (const auto& other : inside) {
+      if (other != key && S->GetFieldEvaluator(other)->IsDependency(S, key)) {
+        is_root = false;
+        break;
+      }
+    }
+    if (is_root) roots.push_back(key);
+  }
+
+  for (const auto& key : roots) {
+    auto eval = S->GetFieldEvaluator(key);
+    for (const auto& other : outside) {
+      if (eval->IsDependency(S, other)) return key + " depends upon " + other;
+    }
+  }
+  return "";
+}
+
+
+// -----------------------------------------------------------------------------
+// Silences the PKs of all subdomains of a domain set.
+// -----------------------------------------------------------------------------
+void
+silenceDomainSetPKs(Teuchos::ParameterList& pks_list, const std::string& ds_name)
+{
+  for (auto p=pks_list.begin(); p!=pks_list.end(); ++p) {
+    const std::string& name = pks_list.name(p);
+    KeyTriple triple;
+    if (pks_list.isSublist(name) && Keys::splitDomainSet(name, triple)
+        && std::get<0>(triple) == ds_name) {
+      pks_list.sublist(name).sublist("verbose object").set<std::string>("verbosity level", "none");
+    }
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Starts a timer, unless in a threaded region.
+// -----------------------------------------------------------------------------
+Teuchos::RCP<Teuchos::TimeMonitor>
+startTimer(Teuchos::Time& timer)
+{
+#ifdef _OPENMP
+  if (omp_in_parallel()) return Teuchos::null;
+#endif
+  return Teuchos::rcp(new Teuchos::TimeMonitor(timer));
+}
+
+
 } // namespace Amanzi
@@ -11,9 +11,14 @@
 
 #pragma once
 
+#include "Teuchos_TimeMonitor.hpp"
+
 #include "Mesh.hh"
 #include "CompositeVector.hh"
 #include "BCs.hh"
+#include "State.hh"
+#include "Debugger.hh"
+#include "boundary_face_index.hh"
 
 namespace Amanzi {
 
@@ -73,4 +78,65 @@ int
 getBoundaryDirection(const AmanziMesh::Mesh& mesh, AmanziMesh::Entity_ID f);
 
 
+// -----------------------------------------------------------------------------
+// Will the debugger write anything on this rank?
+//
+// True if any of the debugger's cells are owned on this rank and that cell's
+// verbose object is at the verbosity the debugger was constructed to write
+// at.  PKs check this once and skip gathering the vectors and names for
+// debugger output entirely when false.
+// -----------------------------------------------------------------------------
+bool
+isDebuggerActive(Debugger& db, const AmanziMesh::Mesh& mesh,
+                 Teuchos::EVerbosityLevel verbosity);
+
+
+// -----------------------------------------------------------------------------
+// Can PKs on this rank be advanced in concurrent threads?
+//
+// Returns the reason why not, or an empty string if they can.  Threads share
+// RCPs and each makes MPI calls on its own communicator, which requires
+// thread-safe Teuchos reference counting and MPI_THREAD_MULTIPLE.
+// -----------------------------------------------------------------------------
+std::string
+getThreadedAdvanceError();
+
+
+// -----------------------------------------------------------------------------
+// Does a subdomain of a domain set depend upon fields outside of it?
+//
+// Returns "KEY depends upon OTHER" for a field KEY of the subdomain whose
+// evaluator depends upon a field OTHER outside of the subdomain, or an empty
+// string if none does.  Fields of all domains with the subdomain's index
+// (e.g. a column and its surface) are considered inside.  Subdomains that may
+// be advanced in concurrent threads must not share any evaluator, as
+// evaluating one updates it.
+// -----------------------------------------------------------------------------
+std::string
+getSubdomainExternalDependency(const Teuchos::Ptr<State>& S, const std::string& subdomain);
+
+
+// -----------------------------------------------------------------------------
+// Silences the PKs of all subdomains of a domain set.
+//
+// Sets the "verbose object" of every PK spec of the domain set, e.g.
+// "column_*-flow", to a verbosity level of "none".  PKs advanced in concurrent
+// threads must not write output, as VerboseObjects are not thread safe.  This
+// must be called before those PKs are constructed.
+// -----------------------------------------------------------------------------
+void
+silenceDomainSetPKs(Teuchos::ParameterList& pks_list, const std::string& ds_name);
+
+
+// -----------------------------------------------------------------------------
+// Starts a timer, unless in a threaded region.
+//
+// Teuchos timers, and the stack of active ones kept by TimeMonitor, are not
+// thread safe, so work done in PKs advanced in concurrent threads is not
+// timed.  Returns null if not timing.
+// -----------------------------------------------------------------------------
+Teuchos::RCP<Teuchos::TimeMonitor>
+startTimer(Teuchos::Time& timer);
+
+
 } // namespace Amanzi
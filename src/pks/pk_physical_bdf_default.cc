@@ -12,6 +12,7 @@ PKPhysicalBase and BDF methods of PK_BDF_Default.
 
 #include "boost/math/special_functions/fpclassify.hpp"
 
+#include "pk_helpers.hh"
 #include "pk_physical_bdf_default.hh"
 
 namespace Amanzi {
@@ -47,6 +48,10 @@ void PK_PhysicalBDF_Default::Setup(const Teuchos::Ptr<State>& S)
   atol_ = plist_->get<double>("absolute error tolerance",1.0);
   rtol_ = plist_->get<double>("relative error tolerance",1.0);
   fluxtol_ = plist_->get<double>("flux error tolerance",1.0);
+
+  // timers are per PK type, not per PK, to keep domain sets summarizable
+  std::string pk_type = plist_->get<std::string>("PK type", name_);
+  residual_timer_ = Teuchos::TimeMonitor::getNewCounter(pk_type+" residual");
 };
 
 
@@ -69,6 +74,29 @@ void PK_PhysicalBDF_Default::Initialize(const Teuchos::Ptr<State>& S)
 // -----------------------------------------------------------------------------
 double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
         Teuchos::RCP<const TreeVector> res)
+{
+  double enorm_val_l = ErrorNormLocal(u, res);
+
+  Teuchos::RCP<const Comm_type> comm_p = mesh_->get_comm();
+  Teuchos::RCP<const MpiComm_type> mpi_comm_p =
+    Teuchos::rcp_dynamic_cast<const MpiComm_type>(comm_p);
+  const MPI_Comm& comm = mpi_comm_p->Comm();
+
+  double enorm_val = 0.0;
+  int ierr;
+  ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, comm);
+  AMANZI_ASSERT(!ierr);
+
+  RecordErrorNorm_(enorm_val);
+  return enorm_val;
+};
+
+
+// -----------------------------------------------------------------------------
+// This rank's contribution to the default enorm.
+// -----------------------------------------------------------------------------
+double PK_PhysicalBDF_Default::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> res)
 {
   // Abs tol based on old conserved quantity -- we know these have been vetted
   // at some level whereas the new quantity is some iterate, and may be
@@ -87,11 +115,6 @@ double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
   Teuchos::RCP<const CompositeVector> dvec = res->Data();
   double h = S_next_->time() - S_inter_->time();
 
-  Teuchos::RCP<const Comm_type> comm_p = mesh_->get_comm();
-  Teuchos::RCP<const MpiComm_type> mpi_comm_p =
-    Teuchos::rcp_dynamic_cast<const MpiComm_type>(comm_p);
-  const MPI_Comm& comm = mpi_comm_p->Comm();
-
   double enorm_val = 0.0;
   for (CompositeVector::name_iterator comp=dvec->begin();
        comp!=dvec->end(); ++comp) {
@@ -115,15 +138,14 @@ double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 
     } else if (*comp == std::string("face")) {
       // error in flux -- relative to cell's extensive conserved quantity
+      UpdateErrorNormFaceCells_();
       int nfaces = dvec->size(*comp, false);
 
       for (unsigned int f=0; f!=nfaces; ++f) {
-        AmanziMesh::Entity_ID_List cells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
-        double cv_min = cells.size() == 1 ? cv[0][cells[0]]
-            : std::min(cv[0][cells[0]],cv[0][cells[1]]);
-        double conserved_min = cells.size() == 1 ? conserved[0][cells[0]]
-            : std::min(conserved[0][cells[0]],conserved[0][cells[1]]);
+        AmanziMesh::Entity_ID c0 = enorm_face_cells_[2*f];
+        AmanziMesh::Entity_ID c1 = enorm_face_cells_[2*f+1];
+        double cv_min = std::min(cv[0][c0], cv[0][c1]);
+        double conserved_min = std::min(conserved[0][c0], conserved[0][c1]);
 
         double enorm_f = fluxtol_ * h * std::abs(dvec_v[0][f])
             / (atol_*cv_min + rtol_*std::abs(conserved_min));
@@ -142,6 +164,11 @@ double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 
     // Write out Inf norms too.
     if (vo_->os_OK(Teuchos::VERB_MEDIUM)) {
+      Teuchos::RCP<const Comm_type> comm_p = mesh_->get_comm();
+      Teuchos::RCP<const MpiComm_type> mpi_comm_p =
+        Teuchos::rcp_dynamic_cast<const MpiComm_type>(comm_p);
+      const MPI_Comm& comm = mpi_comm_p->Comm();
+
       double infnorm(0.);
       dvec_v.NormInf(&infnorm);
 
@@ -159,16 +186,40 @@ double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 
     enorm_val = std::max(enorm_val, enorm_comp);
   }
-
-  double enorm_val_l = enorm_val;
-
-  int ierr;
-  ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, comm);
-  AMANZI_ASSERT(!ierr);
   return enorm_val;
 };
 
 
+// -----------------------------------------------------------------------------
+// Times the rest of a residual evaluation.  Evaluations within a threaded
+// region are not timed, see startTimer().
+// -----------------------------------------------------------------------------
+Teuchos::RCP<Teuchos::TimeMonitor> PK_PhysicalBDF_Default::MonitorResidual_()
+{
+  return startTimer(*residual_timer_);
+}
+
+
+// -----------------------------------------------------------------------------
+// Table of the owned cells of each owned face, for flux error norms.  This is
+// topological and computed once; volumes are read on every call, as they
+// change on deforming meshes.
+// -----------------------------------------------------------------------------
+void PK_PhysicalBDF_Default::UpdateErrorNormFaceCells_()
+{
+  int nfaces = mesh_->num_entities(AmanziMesh::FACE, AmanziMesh::Parallel_type::OWNED);
+  if ((int) enorm_face_cells_.size() != 2*nfaces) {
+    enorm_face_cells_.resize(2*nfaces);
+    AmanziMesh::Entity_ID_List cells;
+    for (int f=0; f!=nfaces; ++f) {
+      mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
+      enorm_face_cells_[2*f] = cells[0];
+      enorm_face_cells_[2*f+1] = cells.size() == 1 ? cells[0] : cells[1];
+    }
+  }
+}
+
+
   // void PK_PhysicalBDF_Default::Solution_to_State(TreeVector& solution,
   //                                                 const Teuchos::RCP<State>& S){
   //   PK_Physical_Default::Solution_to_State(solution, S);
@@ -57,6 +57,8 @@ code, so usually are not supplied by the user.
 #ifndef ATS_PK_PHYSICAL_BDF_BASE_HH_
 #define ATS_PK_PHYSICAL_BDF_BASE_HH_
 
+#include "Teuchos_TimeMonitor.hpp"
+
 #include "errors.hh"
 #include "pk_bdf_default.hh"
 #include "pk_physical_default.hh"
@@ -105,6 +107,11 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
   virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
                        Teuchos::RCP<const TreeVector> du) override;
 
+  // -- This rank's contribution to ErrorNorm(), which is its max over ranks.
+  //    Subclasses with their own norm override this rather than ErrorNorm().
+  virtual double ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+          Teuchos::RCP<const TreeVector> du) override;
+
   virtual bool ValidStep() override {
     return PK_Physical_Default::ValidStep() && PK_BDF_Default::ValidStep();
   }
@@ -137,6 +144,15 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
   Key cell_vol_key_;
   double atol_, rtol_, fluxtol_;
 
+  // -- flux error norm table: the owned cells of each owned face, the second
+  //    repeating the first if there is only one
+  void UpdateErrorNormFaceCells_();
+  std::vector<AmanziMesh::Entity_ID> enorm_face_cells_;
+
+  // residual timer
+  Teuchos::RCP<Teuchos::TimeMonitor> MonitorResidual_();
+  Teuchos::RCP<Teuchos::Time> residual_timer_;
+
 };
 
 
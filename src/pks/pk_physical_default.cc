@@ -18,7 +18,8 @@ PK_Physical_Default::PK_Physical_Default(Teuchos::ParameterList& pk_tree,
                                          const Teuchos::RCP<State>& S,
                                          const Teuchos::RCP<TreeVector>& solution) :
     PK(pk_tree, glist, S, solution),
-    PK_Physical(pk_tree, glist, S, solution)
+    PK_Physical(pk_tree, glist, S, solution),
+    db_verbosity_(Teuchos::VERB_HIGH)
 {
   key_ = Keys::readKey(*plist_, domain_, "primary variable");
 
@@ -48,7 +49,7 @@ void PK_Physical_Default::Setup(const Teuchos::Ptr<State>& S) {
   mesh_ = S->GetMesh(domain_);
 
   // set up the debugger
-  db_ = Teuchos::rcp(new Debugger(mesh_, name_, *plist_));
+  db_ = Teuchos::rcp(new Debugger(mesh_, name_, *plist_, db_verbosity_));
 
   // require primary variable evaluator
   S->RequireFieldEvaluator(key_);
@@ -73,11 +73,17 @@ class PK_Physical_Default : public PK_Physical {
   // -- initialize
   virtual void Initialize(const Teuchos::Ptr<State>& S);
 
+  // -- verbosity at which the debugger writes
+  Teuchos::EVerbosityLevel debugger_verbosity() const { return db_verbosity_; }
+
  protected: // data
 
   // step validity
   double max_valid_change_;
 
+  // verbosity at which db_ writes
+  Teuchos::EVerbosityLevel db_verbosity_;
+
   // ENORM struct
   typedef struct ENorm_t {
     double value;
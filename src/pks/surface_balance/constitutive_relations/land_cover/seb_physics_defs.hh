@@ -123,6 +123,25 @@ struct GroundProperties {
 };
 
 
+// Derivatives of the ground properties that vary with some input, i.e. the
+// surface temperature or ponded depth, with respect to that input.
+struct GroundPropertiesDerivative {
+  double temp;
+  double pressure;
+  double ponded_depth;
+  double porosity;
+  double saturation_gas;
+
+  GroundPropertiesDerivative() :
+      temp(0.),
+      pressure(0.),
+      ponded_depth(0.),
+      porosity(0.),
+      saturation_gas(0.)
+  {}
+};
+
+
 // Struct of snow state
 struct SnowProperties {
   double height;                // snow depth [m] (NOT SWE!)
@@ -11,9 +11,12 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include "boost/math/tools/roots.hpp"
 
 #include "dbc.hh"
+#include "errors.hh"
+#include "exceptions.hh"
 
 #include "seb_physics_funcs.hh"
 
@@ -23,6 +26,7 @@ namespace Relations {
 
 #define SWE_EPS 1.e-12
 #define ENERGY_BALANCE_TOL 1.e-8
+#define SNOW_TEMPERATURE_MAX_STEP 10.
 
 
 double CalcAlbedoSnow(double density_snow) {
@@ -101,6 +105,19 @@ double StabilityFunction(double air_temp, double skin_temp, double Us,
 }
 
 
+double StabilityFunctionDerivative(double air_temp, double skin_temp, double Us,
+        double Z_Us, double c_gravity)
+{
+  double Ri_coef = c_gravity * Z_Us / (air_temp * std::pow(Us,2));
+  double Ri = Ri_coef * (air_temp - skin_temp);
+  if (Ri >= 0.) {
+    return 10 * Ri_coef / std::pow(1 + 10*Ri, 2);
+  } else {
+    return 10 * Ri_coef;
+  }
+}
+
+
 double SaturatedVaporPressure(double temp)
 {
   // Sat vap. press o/water Dingman D-7 (Bolton, 1980)
@@ -111,6 +128,12 @@ double SaturatedVaporPressure(double temp)
   return 1e2 * vp_mbar;
 }
 
+double SaturatedVaporPressureDerivative(double temp)
+{
+  double tempC = temp - 273.15;
+  return SaturatedVaporPressure(temp) * 17.67 * 243.5 / std::pow(tempC + 243.5, 2);
+}
+
 double SaturatedVaporPressureELM(double temp)
 {
   // Saturated vapor pressure in [KPa] from CLM technical note
@@ -202,6 +225,28 @@ double EvaporativeResistanceCoef(double saturation_gas,
 }
 
 
+double EvaporativeResistanceCoefDerivative(double saturation_gas,
+        double porosity, double dessicated_zone_thickness, double Clapp_Horn_b,
+        double d_saturation_gas, double d_porosity)
+{
+  if (saturation_gas == 0.) return 0.;
+
+  // see EvaporativeResistanceCoef()
+  double s_res = std::min(0.0556 / porosity, 0.4);
+  double d_s_res = 0.0556 / porosity < 0.4 ? -0.0556 / std::pow(porosity,2) * d_porosity : 0.;
+  double n = 2 + 3*Clapp_Horn_b;
+  double vp_diffusion = 0.000022 * std::pow(porosity,2) * std::pow(1-s_res, n);
+  double d_vp_diffusion = 0.000022 * (2 * porosity * d_porosity * std::pow(1-s_res, n)
+          - std::pow(porosity,2) * n * std::pow(1-s_res, n-1) * d_s_res);
+
+  double L_Rsoil = dessicated_zone_thickness *
+    (std::exp(std::pow(saturation_gas, 5)) - 1) / (std::exp(1)-1);
+  double d_L_Rsoil = dessicated_zone_thickness * std::exp(std::pow(saturation_gas, 5))
+    * 5 * std::pow(saturation_gas, 4) * d_saturation_gas / (std::exp(1)-1);
+  return d_L_Rsoil / vp_diffusion - L_Rsoil * d_vp_diffusion / std::pow(vp_diffusion,2);
+}
+
+
 double SensibleHeat(double resistance_coef,
                     double density_air,
                     double Cp_air,
@@ -222,16 +267,21 @@ double LatentHeat(double resistance_coef,
     * (vapor_pressure_air - vapor_pressure_skin) / p_atm;
 }
 
-double ConductedHeatIfSnow(double ground_temp,
-                           const SnowProperties& snow, const ModelParams& params)
+double ThermalConductivitySnow(double density_snow, const ModelParams& params)
 {
-  // Calculate heat conducted to ground, if snow
-  double density = snow.density;
+  double density = density_snow;
   if (density > 150) {
     // adjust for frost hoar
     density = 1. / ((0.90/density) + (0.10/150));
   }
-  double Ks = params.thermalK_freshsnow * std::pow(density/params.density_freshsnow, params.thermalK_snow_exp);
+  return params.thermalK_freshsnow * std::pow(density/params.density_freshsnow, params.thermalK_snow_exp);
+}
+
+double ConductedHeatIfSnow(double ground_temp,
+                           const SnowProperties& snow, const ModelParams& params)
+{
+  // Calculate heat conducted to ground, if snow
+  double Ks = ThermalConductivitySnow(snow.density, params);
   return Ks * (snow.temp - ground_temp) / snow.height;
 }
 
@@ -275,6 +325,17 @@ EnergyBalance UpdateEnergyBalanceWithSnow(const GroundProperties& surf,
   // snow on the ground, solve for snow temperature
   std::tie(eb.fQswIn, eb.fQlwIn) = IncomingRadiation(met, snow.albedo);
   snow.temp = DetermineSnowTemperature(surf, met, params, snow, eb);
+  return UpdateEnergyBalanceWithSnowTemperature(surf, met, params, snow);
+}
+
+
+EnergyBalance UpdateEnergyBalanceWithSnowTemperature(const GroundProperties& surf,
+        const MetData& met,
+        const ModelParams& params,
+        SnowProperties& snow)
+{
+  EnergyBalance eb;
+  std::tie(eb.fQswIn, eb.fQlwIn) = IncomingRadiation(met, snow.albedo);
 
   if (snow.temp > 273.15) {
     // limit snow temp to 0, then melt with the remaining energy
@@ -336,6 +397,67 @@ EnergyBalance UpdateEnergyBalanceWithoutSnow(const GroundProperties& surf,
   return eb;
 }
 
+EnergyBalance UpdateEnergyBalanceWithoutSnowDerivative(const GroundProperties& surf,
+        const MetData& met,
+        const ModelParams& params,
+        const GroundPropertiesDerivative& dsurf)
+{
+  EnergyBalance deb;
+  deb.fQswIn = 0.;
+  deb.fQlwIn = 0.;
+  deb.error = 0.;
+
+  // outgoing radiation
+  deb.fQlwOut = 4 * surf.emissivity * c_stephan_boltzmann * std::pow(surf.temp,3) * dsurf.temp;
+
+  // melting of incoming precip
+  if (surf.temp > 273.15 && surf.temp <= 273.65) {
+    double Em = (met.Ps + surf.snow_death_rate) * surf.density_w * params.H_fusion;
+    deb.fQm = Em * dsurf.temp / (0.5);
+  } else {
+    deb.fQm = 0.;
+  }
+
+  // sensible heat
+  double Dhe = WindFactor(met.Us, met.Z_Us, surf.roughness);
+  double Sqig = StabilityFunction(met.air_temp, surf.temp, met.Us, met.Z_Us, params.gravity);
+  double d_Sqig = StabilityFunctionDerivative(met.air_temp, surf.temp, met.Us, met.Z_Us, params.gravity)
+    * dsurf.temp;
+  deb.fQh = params.density_air * params.Cp_air * Dhe *
+    (d_Sqig * (met.air_temp - surf.temp) - Sqig * dsurf.temp);
+
+  // latent heat
+  double vapor_pressure_air = VaporPressureAir(met.air_temp, met.relative_humidity);
+  double vapor_pressure_skin = VaporPressureGround(surf, params);
+  double d_vapor_pressure_skin;
+  if (surf.pressure < params.P_atm) {
+    double pc = params.P_atm - surf.pressure;
+    double a = surf.density_w * c_R_ideal_gas * surf.temp;
+    double relative_humidity = std::exp(-pc / a);
+    double d_relative_humidity = relative_humidity *
+      (dsurf.pressure / a + pc * dsurf.temp / (a * surf.temp));
+    d_vapor_pressure_skin = d_relative_humidity * SaturatedVaporPressure(surf.temp)
+      + relative_humidity * SaturatedVaporPressureDerivative(surf.temp) * dsurf.temp;
+  } else {
+    d_vapor_pressure_skin = SaturatedVaporPressureDerivative(surf.temp) * dsurf.temp;
+  }
+
+  double Rsoil = EvaporativeResistanceGround(surf, met, params, vapor_pressure_air, vapor_pressure_skin);
+  double d_Rsoil = Rsoil == 0. ? 0. :
+    EvaporativeResistanceCoefDerivative(surf.saturation_gas, surf.porosity, surf.dz,
+            params.Clapp_Horn_b, dsurf.saturation_gas, dsurf.porosity);
+  double coef = 1.0 / (Rsoil + 1.0/(Dhe*Sqig));
+  double d_coef = coef * coef * (d_Sqig / (Dhe * Sqig * Sqig) - d_Rsoil);
+
+  double lh = params.density_air * 0.622 / params.P_atm *
+    (surf.unfrozen_fraction * params.H_vaporization + (1-surf.unfrozen_fraction) * params.H_sublimation);
+  deb.fQe = lh * (d_coef * (vapor_pressure_air - vapor_pressure_skin) - coef * d_vapor_pressure_skin);
+
+  deb.fQc = -deb.fQlwOut + deb.fQh + deb.fQe;
+  return deb;
+}
+
+
 // Snow temperature calculation.
 double DetermineSnowTemperature(const GroundProperties& surf,
         const MetData& met,
@@ -395,6 +517,170 @@ double DetermineSnowTemperature(const GroundProperties& surf,
 }
 
 
+// Batched snow temperature calculation.
+void SnowTemperatureBatch::clear()
+{
+  temp.clear();
+  iterations.clear();
+  Qin_.clear();
+  emissivity_.clear();
+  Dhe_.clear();
+  air_temp_.clear();
+  Ri_coef_.clear();
+  vp_air_.clear();
+  conductance_.clear();
+  ground_temp_.clear();
+}
+
+
+void SnowTemperatureBatch::push_back(const GroundProperties& surf,
+        const MetData& met, const SnowProperties& snow, double T0)
+{
+  temp.push_back(std::isfinite(T0) ? T0 : surf.temp);
+
+  auto rad = IncomingRadiation(met, snow.albedo);
+  Qin_.push_back(rad.first + rad.second);
+  emissivity_.push_back(snow.emissivity);
+  Dhe_.push_back(WindFactor(met.Us, met.Z_Us,
+                            CalcRoughnessFactor(snow.height, surf.roughness, snow.roughness)));
+  air_temp_.push_back(met.air_temp);
+  // see StabilityFunction()
+  Ri_coef_.push_back(params_.gravity * met.Z_Us / (met.air_temp * std::pow(met.Us,2)));
+  vp_air_.push_back(VaporPressureAir(met.air_temp, met.relative_humidity));
+  conductance_.push_back(ThermalConductivitySnow(snow.density, params_) / snow.height);
+  ground_temp_.push_back(surf.temp);
+}
+
+
+double SnowTemperatureBatch::Residual(int i, double T, double& dres_dT) const
+{
+  EnergyBalance eb, deb;
+  Terms_(i, T, eb, deb);
+  dres_dT = deb.fQm;
+  return eb.fQm;
+}
+
+
+EnergyBalance SnowTemperatureBatch::DerivativeGroundTemperature(int i) const
+{
+  EnergyBalance deb;
+  deb.fQswIn = 0.;
+  deb.fQlwIn = 0.;
+  deb.error = 0.;
+
+  if (temp[i] > 273.15) {
+    // snow temperature is limited to 0 C, so only conduction changes, and
+    // that change goes into melting
+    deb.fQlwOut = 0.;
+    deb.fQh = 0.;
+    deb.fQe = 0.;
+    deb.fQc = -conductance_[i];
+    deb.fQm = conductance_[i];
+  } else {
+    EnergyBalance eb, deb_dTs;
+    Terms_(i, temp[i], eb, deb_dTs);
+
+    // differentiate fQm(T_snow(T_ground), T_ground) = 0
+    double dTs = -conductance_[i] / deb_dTs.fQm;
+    deb.fQlwOut = deb_dTs.fQlwOut * dTs;
+    deb.fQh = deb_dTs.fQh * dTs;
+    deb.fQe = deb_dTs.fQe * dTs;
+    deb.fQc = conductance_[i] * (dTs - 1);
+    deb.fQm = 0.;
+  }
+  return deb;
+}
+
+
+void SnowTemperatureBatch::Terms_(int i, double T, EnergyBalance& eb, EnergyBalance& deb) const
+{
+  // The terms of UpdateEnergyBalanceWithSnow_Inner(), along with their
+  // derivatives with respect to snow temperature.
+  double T3 = T*T*T;
+  eb.fQlwOut = emissivity_[i] * c_stephan_boltzmann * T3*T;
+  deb.fQlwOut = 4 * emissivity_[i] * c_stephan_boltzmann * T3;
+
+  // stability function, continuously differentiable at Ri = 0
+  double Ri = Ri_coef_[i] * (air_temp_[i] - T);
+  double denom = 1 + 10*std::max(Ri, 0.);
+  double Sqig = Ri >= 0. ? 1. / denom : 1 - 10*Ri;
+  double d_Sqig = 10 * Ri_coef_[i] / (denom*denom);
+
+  double coef = Dhe_[i] * Sqig;
+  double d_coef = Dhe_[i] * d_Sqig;
+
+  double sh = params_.density_air * params_.Cp_air;
+  eb.fQh = coef * sh * (air_temp_[i] - T);
+  deb.fQh = sh * (d_coef * (air_temp_[i] - T) - coef);
+
+  double vp_skin = SaturatedVaporPressure(T);
+  double d_vp_skin = SaturatedVaporPressureDerivative(T);
+  double lh = params_.density_air * params_.H_sublimation * 0.622 / params_.P_atm;
+  eb.fQe = coef * lh * (vp_air_[i] - vp_skin);
+  deb.fQe = lh * (d_coef * (vp_air_[i] - vp_skin) - coef * d_vp_skin);
+
+  eb.fQc = conductance_[i] * (T - ground_temp_[i]);
+  deb.fQc = conductance_[i];
+
+  eb.fQm = Qin_[i] - eb.fQlwOut + eb.fQh - eb.fQc + eb.fQe;
+  deb.fQm = -deb.fQlwOut + deb.fQh - deb.fQc + deb.fQe;
+}
+
+
+int SnowTemperatureBatch::Solve(int max_it)
+{
+  int n = size();
+  iterations.assign(n, 0);
+  lo_.assign(n, -std::numeric_limits<double>::infinity());
+  hi_.assign(n, std::numeric_limits<double>::infinity());
+  active_.resize(n);
+  for (int i=0; i!=n; ++i) active_[i] = i;
+
+  int n_evals = 0;
+  for (int it=0; it!=max_it && active_.size() > 0; ++it) {
+    // One step on every unconverged patch.  Converged patches are dropped
+    // from the active list so that each sweep stays a dense loop.
+    int n_active = 0;
+    for (int i : active_) {
+      double T = temp[i];
+      double dres;
+      double res = Residual(i, T, dres);
+      iterations[i]++;
+
+      // fQm decreases with snow temperature, so its sign brackets the root
+      if (res > 0.) lo_[i] = T;
+      else hi_[i] = T;
+
+      double step = res == 0. ? 0. : -res / dres;
+      if (!(dres < 0.) || !(std::abs(step) <= SNOW_TEMPERATURE_MAX_STEP)) {
+        // no useful derivative or a wild step, move toward the root
+        step = res > 0. ? SNOW_TEMPERATURE_MAX_STEP : -SNOW_TEMPERATURE_MAX_STEP;
+      }
+      double T_new = T + step;
+      if (std::isfinite(lo_[i]) && std::isfinite(hi_[i]) &&
+          !(T_new > lo_[i] && T_new < hi_[i])) {
+        T_new = (lo_[i] + hi_[i]) / 2.;
+      }
+      temp[i] = T_new;
+
+      bool converged = std::abs(T_new - T) <= ENERGY_BALANCE_TOL ||
+                       hi_[i] - lo_[i] <= ENERGY_BALANCE_TOL;
+      if (!converged) active_[n_active++] = i;
+    }
+    n_evals += active_.size();
+    active_.resize(n_active);
+  }
+
+  if (active_.size() > 0) {
+    Errors::Message msg;
+    msg << "Nonconverged Surface Energy Balance: snow temperature did not converge on "
+        << (int) active_.size() << " of " << n << " patches in " << max_it << " iterations.";
+    Exceptions::amanzi_throw(msg);
+  }
+  return n_evals;
+}
+
+
 MassBalance UpdateMassBalanceWithSnow(const GroundProperties& surf,
         const ModelParams& params, const EnergyBalance& eb)
 {
@@ -485,6 +771,55 @@ FluxBalance UpdateFluxesWithoutSnow(const GroundProperties& surf,
 }
 
 
+FluxBalance UpdateFluxesWithoutSnowDerivative(const GroundProperties& surf,
+        const MetData& met, const ModelParams& params, const MassBalance& mb,
+        const GroundPropertiesDerivative& dsurf, const EnergyBalance& deb,
+        const MassBalance& dmb, bool model_1p1)
+{
+  FluxBalance dflux;
+  dflux.M_surf = dmb.Mm;
+  dflux.E_surf = -deb.fQlwOut + deb.fQh - deb.fQm + deb.fQe;
+
+  // see UpdateFluxesWithoutSnow()
+  double evap_to_subsurface_fraction, d_evap_to_subsurface_fraction = 0.;
+  if (model_1p1) {
+    if (mb.Me < 0) {
+      if (surf.pressure >= params.P_atm + params.evap_transition_width) {
+        evap_to_subsurface_fraction = 0.;
+      } else if (surf.pressure < params.P_atm) {
+        evap_to_subsurface_fraction = 1.;
+      } else {
+        evap_to_subsurface_fraction = (params.P_atm + params.evap_transition_width - surf.pressure) / (params.evap_transition_width);
+        d_evap_to_subsurface_fraction = -dsurf.pressure / params.evap_transition_width;
+      }
+    } else {
+      evap_to_subsurface_fraction = 0.;
+    }
+  } else {
+    evap_to_subsurface_fraction = 1 - std::min(1.0,
+          surf.ponded_depth / surf.water_transition_depth);
+    if (surf.ponded_depth < surf.water_transition_depth)
+      d_evap_to_subsurface_fraction = -dsurf.ponded_depth / surf.water_transition_depth;
+  }
+
+  dflux.M_surf += (1 - evap_to_subsurface_fraction) * dmb.Me - d_evap_to_subsurface_fraction * mb.Me;
+  dflux.M_subsurf = evap_to_subsurface_fraction * dmb.Me + d_evap_to_subsurface_fraction * mb.Me;
+  dflux.E_subsurf = 0.;
+  dflux.M_snow = -dmb.Mm;
+  return dflux;
+}
+
+
+FluxBalance UpdateFluxesWithSnowDerivative(const EnergyBalance& deb, const MassBalance& dmb)
+{
+  FluxBalance dflux;
+  dflux.M_surf = dmb.Mm;
+  dflux.M_snow = dmb.Me - dmb.Mm;
+  dflux.E_surf = deb.fQc;
+  return dflux;
+}
+
+
 FluxBalance UpdateFluxesWithSnow(const GroundProperties& surf,
         const MetData& met, const ModelParams& params, const SnowProperties& snow,
         const EnergyBalance& eb, const MassBalance& mb)
@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include "VerboseObject.hh"
 #include "seb_physics_defs.hh"
@@ -61,12 +62,20 @@ double StabilityFunction(double air_temp, double skin_temp, double Us,
                          double Z_Us, double c_gravity);
 
 
+//
+// Derivative of the stability function with respect to skin temperature.
+// ------------------------------------------------------------------------------------------
+double StabilityFunctionDerivative(double air_temp, double skin_temp, double Us,
+        double Z_Us, double c_gravity);
+
+
 //
 // Partial pressure of water vapor in air, saturated.
 // After Dingman D-7 (Bolton, 1980).
 // In [kPa]
 // ------------------------------------------------------------------------------------------
 double SaturatedVaporPressure(double temp);
+double SaturatedVaporPressureDerivative(double temp);
 
 double SaturatedVaporPressureELM(double temp);
 double SaturatedSpecificHumidityELM(double temp);
@@ -98,6 +107,10 @@ double EvaporativeResistanceGround(const GroundProperties& surf,
 double EvaporativeResistanceCoef(double saturation_gas,
         double porosity, double dessicated_zone_thickness, double Clapp_Horn_b);
 
+double EvaporativeResistanceCoefDerivative(double saturation_gas,
+        double porosity, double dessicated_zone_thickness, double Clapp_Horn_b,
+        double d_saturation_gas, double d_porosity);
+
 
 //
 // Basic sensible heat.
@@ -118,11 +131,17 @@ double LatentHeat(double resistance_coef,
                   double vapor_pressure_skin,
                   double Apa);
 
+//
+// Thermal conductivity of snow as a function of density.
+// ------------------------------------------------------------------------------------------
+double ThermalConductivitySnow(double density_snow, const ModelParams& params);
+
 //
 // Heat conducted to ground via simple diffusion model between snow and skin surface.
 // ------------------------------------------------------------------------------------------
 double ConductedHeatIfSnow(double ground_temp,
-                           const SnowProperties& snow);
+                           const SnowProperties& snow,
+                           const ModelParams& params);
 
 //
 // Update the energy balance, solving for the amount of heat available to melt snow.
@@ -149,6 +168,17 @@ double DetermineSnowTemperature(const GroundProperties& surf,
         std::string method="toms");
 
 
+//
+// Update the energy balance given a snow temperature that balances energy,
+// i.e. from DetermineSnowTemperature() or SnowTemperatureBatch.  If that
+// temperature is above 0 C, it is limited to 0 C and the remaining energy goes
+// into melting.
+// ------------------------------------------------------------------------------------------
+EnergyBalance UpdateEnergyBalanceWithSnowTemperature(const GroundProperties& surf,
+        const MetData& met,
+        const ModelParams& params,
+        SnowProperties& snow);
+
 //
 // Update the energy balance, solving for the amount of heat conducted to the ground.
 //
@@ -168,9 +198,21 @@ EnergyBalance UpdateEnergyBalanceWithoutSnow(const GroundProperties& surf,
         const MetData& met,
         const ModelParams& params);
 
+//
+// Derivative of UpdateEnergyBalanceWithoutSnow() with respect to some input,
+// given the derivatives of the ground properties with respect to that input.
+// ------------------------------------------------------------------------------------------
+EnergyBalance UpdateEnergyBalanceWithoutSnowDerivative(const GroundProperties& surf,
+        const MetData& met,
+        const ModelParams& params,
+        const GroundPropertiesDerivative& dsurf);
+
 //
 // Given an energy balance, determine the resulting mass changes between
 // precip, evaporation, melt, etc, with snow.
+//
+// NOTE, the mass balances are linear in the energy balance, so these also map
+// the derivative of an energy balance to that of the mass balance.
 // ------------------------------------------------------------------------------------------
 MassBalance UpdateMassBalanceWithSnow(const GroundProperties& surf,
         const ModelParams& params, const EnergyBalance& eb);
@@ -199,6 +241,17 @@ FluxBalance UpdateFluxesWithoutSnow(const GroundProperties& surf,
         const MetData& met, const ModelParams& params, const EnergyBalance& eb,
         const MassBalance& mb, bool model_1p1=false);
 
+//
+// Derivatives of UpdateFluxesWithoutSnow() and UpdateFluxesWithSnow(), given
+// the derivatives of the energy and mass balances.
+// ------------------------------------------------------------------------------------------
+FluxBalance UpdateFluxesWithoutSnowDerivative(const GroundProperties& surf,
+        const MetData& met, const ModelParams& params, const MassBalance& mb,
+        const GroundPropertiesDerivative& dsurf, const EnergyBalance& deb,
+        const MassBalance& dmb, bool model_1p1=false);
+
+FluxBalance UpdateFluxesWithSnowDerivative(const EnergyBalance& deb, const MassBalance& dmb);
+
 
 
 // Calculation of a snow temperature requires a root-finding operation, for
@@ -234,6 +287,65 @@ class SnowTemperatureFunctor_ {
 };
 
 
+// Batched calculation of snow temperature.
+//
+// Collects, as a struct of arrays, the temperature-independent terms of the
+// snow energy balance for a batch of snow-covered patches (typically all snow
+// patches of one land cover type), then solves fQm(T_snow) = 0 on all of them
+// together by a safeguarded Newton iteration.  Each patch starts from its own
+// initial guess, typically the solution of the previous evaluation, steps
+// with the analytic derivative of fQm, and bisects its current bracket
+// whenever a Newton step leaves it.  As in DetermineSnowTemperature(), the
+// solution is not limited to 0 C.
+class SnowTemperatureBatch {
+ public:
+  explicit SnowTemperatureBatch(const ModelParams& params) : params_(params) {}
+
+  void clear();
+  int size() const { return temp.size(); }
+
+  // Adds a patch, starting the solve from T0.  If T0 is not finite, the
+  // ground temperature is used.
+  void push_back(const GroundProperties& surf, const MetData& met,
+                 const SnowProperties& snow, double T0);
+
+  // Solves for temp on all patches, returning the total number of residual
+  // evaluations.
+  int Solve(int max_it=100);
+
+  // Energy available for melting, fQm, at snow temperature T, and its
+  // derivative with respect to T.
+  double Residual(int i, double T, double& dres_dT) const;
+
+  // Derivatives of the energy balance terms, as limited by
+  // UpdateEnergyBalanceWithSnowTemperature(), with respect to the ground
+  // temperature, given the solution temp[i].
+  EnergyBalance DerivativeGroundTemperature(int i) const;
+
+  std::vector<double> temp;     // [K] initial guess on input, solution on output
+  std::vector<int> iterations;  // residual evaluations of each patch
+
+ private:
+  // energy balance terms and their derivatives with respect to T
+  void Terms_(int i, double T, EnergyBalance& eb, EnergyBalance& deb) const;
+
+ private:
+  ModelParams params_;
+
+  std::vector<double> Qin_;           // [W m^-2] absorbed short- and longwave
+  std::vector<double> emissivity_;    // [-]
+  std::vector<double> Dhe_;           // [m s^-1] wind factor
+  std::vector<double> air_temp_;      // [K]
+  std::vector<double> Ri_coef_;       // [K^-1] Richardson number per degree
+  std::vector<double> vp_air_;        // [Pa]
+  std::vector<double> conductance_;   // [W m^-2 K^-1] snow conductivity / height
+  std::vector<double> ground_temp_;   // [K]
+
+  std::vector<double> lo_, hi_;
+  std::vector<int> active_;
+};
+
+
 // Convergence criteria for root-finding
 struct Tol_ {
   Tol_(double eps) : eps_(eps) {}
@@ -25,6 +25,8 @@ respectively.
 
 */
 
+#include <algorithm>
+
 #include "VerboseObject.hh"
 #include "seb_threecomponent_evaluator.hh"
 #include "seb_physics_defs.hh"
@@ -34,6 +36,25 @@ namespace Amanzi {
 namespace SurfaceBalance {
 namespace Relations {
 
+namespace {
+
+// Adds one patch's area-weighted flux derivatives to those of the sources,
+// in the order of the first six of my_keys_.
+void
+AddPatchDerivatives(std::vector<std::vector<double> >& dsources, AmanziMesh::Entity_ID c,
+                    double area_frac, const Relations::FluxBalance& dflux,
+                    double ss_water_factor, double ss_energy_factor, double dnew_snow)
+{
+  dsources[0][c] += area_frac * dflux.M_surf;
+  dsources[1][c] += area_frac * dflux.E_surf * 1.e-6;
+  dsources[2][c] += area_frac * dflux.M_subsurf * ss_water_factor;
+  dsources[3][c] += area_frac * dflux.E_subsurf * ss_energy_factor * 1.e-6;
+  dsources[4][c] += area_frac * dflux.M_snow;
+  dsources[5][c] += area_frac * dnew_snow;
+}
+
+} // namespace
+
 SEBThreeComponentEvaluator::SEBThreeComponentEvaluator(Teuchos::ParameterList& plist) :
     SecondaryVariablesFieldEvaluator(plist),
     compatible_(false),
@@ -238,12 +259,33 @@ SEBThreeComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
     qE_cond->PutScalar(0.);
   }
 
-  unsigned int ncells = water_source.MyLength();
+  // snow temperature is solved for all snow patches of a land cover together,
+  // warm-started from the previous evaluation
+  if (snow_temp_guess_.size() != (std::size_t) water_source.MyLength())
+    snow_temp_guess_.assign(water_source.MyLength(), NaN);
+  Relations::SnowTemperatureBatch snow_batch(params);
+  std::vector<AmanziMesh::Entity_ID> snow_cells;
+  std::vector<Relations::GroundProperties> snow_surfs;
+  std::vector<Relations::MetData> snow_mets;
+  std::vector<Relations::SnowProperties> snow_props;
+  int n_snow_patches = 0, n_snow_evals = 0, max_snow_its = 0;
+
+  // derivatives with respect to surface temperature, computed with the sources
+  for (auto& dsource : dsources_dT_) std::fill(dsource.begin(), dsource.end(), 0.);
+  Relations::GroundPropertiesDerivative dsurf_dT;
+  dsurf_dT.temp = 1.;
+
   for (const auto& lc : land_cover_) {
     AmanziMesh::Entity_ID_List lc_ids;
     mesh.get_set_entities(lc.first, AmanziMesh::Entity_kind::CELL,
                            AmanziMesh::Parallel_type::OWNED, &lc_ids);
 
+    snow_batch.clear();
+    snow_cells.clear();
+    snow_surfs.clear();
+    snow_mets.clear();
+    snow_props.clear();
+
     for (auto c : lc_ids) {
       // get the top cell
       AmanziMesh::Entity_ID subsurf_f = mesh.entity_get_parent(AmanziMesh::CELL, c);
@@ -305,6 +347,12 @@ SEBThreeComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         snow_source[0][c] += area_fracs[0][c] * flux.M_snow;
         new_snow[0][c] += area_fracs[0][c] * met.Ps;
 
+        const Relations::EnergyBalance deb = Relations::UpdateEnergyBalanceWithoutSnowDerivative(surf, met, params, dsurf_dT);
+        const Relations::MassBalance dmb = Relations::UpdateMassBalanceWithoutSnow(surf, params, deb);
+        Relations::FluxBalance dflux = Relations::UpdateFluxesWithoutSnowDerivative(surf, met, params, mb, dsurf_dT, deb, dmb);
+        AddPatchDerivatives(dsources_dT_, c, area_fracs[0][c], dflux,
+                            area_to_volume * mol_dens[0][c], area_to_volume, 0.);
+
         if (vo_->os_OK(Teuchos::VERB_EXTREME))
           *vo_->os() << "CELL " << c << " BARE"
                      << ": Ms = " << flux.M_surf << ", Es = " << flux.E_surf * 1.e-6
@@ -373,6 +421,12 @@ SEBThreeComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         snow_source[0][c] += area_fracs[1][c] * flux.M_snow;
         new_snow[0][c] += area_fracs[1][c] * met.Ps;
 
+        const Relations::EnergyBalance deb = Relations::UpdateEnergyBalanceWithoutSnowDerivative(surf, met, params, dsurf_dT);
+        const Relations::MassBalance dmb = Relations::UpdateMassBalanceWithoutSnow(surf, params, deb);
+        Relations::FluxBalance dflux = Relations::UpdateFluxesWithoutSnowDerivative(surf, met, params, mb, dsurf_dT, deb, dmb);
+        AddPatchDerivatives(dsources_dT_, c, area_fracs[1][c], dflux,
+                            area_to_volume * mol_dens[0][c], area_to_volume, 0.);
+
         if (vo_->os_OK(Teuchos::VERB_EXTREME))
           *vo_->os() << "CELL " << c << " WATER"
                      << ": Ms = " << flux.M_surf << ", Es = " << flux.E_surf * 1.e-6
@@ -428,39 +482,71 @@ SEBThreeComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         snow.emissivity = surf.emissivity;
         snow.roughness = lc.second.roughness_snow;
 
-        const Relations::EnergyBalance eb = Relations::UpdateEnergyBalanceWithSnow(surf, met, params, snow);
-        const Relations::MassBalance mb = Relations::UpdateMassBalanceWithSnow(surf, params, eb);
-        Relations::FluxBalance flux = Relations::UpdateFluxesWithSnow(surf, met, params, snow, eb, mb);
-
-        // fQe, Me positive is condensation, water flux positive to surface.  Subsurf is 0 because of snow
-        water_source[0][c] += area_fracs[2][c] * flux.M_surf;
-        energy_source[0][c] += area_fracs[2][c] * flux.E_surf * 1.e-6; // convert to MW/m^2 from W/m^2
-        snow_source[0][c] += area_fracs[2][c] * flux.M_snow;
-        new_snow[0][c] += (met.Ps + std::max(mb.Me, 0.)) * area_fracs[2][c];
-
-        if (vo_->os_OK(Teuchos::VERB_EXTREME))
-          *vo_->os() << "CELL " << c << " SNOW"
-                     << ": Ms = " << flux.M_surf << ", Es = " << flux.E_surf * 1.e-6
-                     << ", Mss = " << 0. << ", Ess = " << 0.
-                     << ", Sn = " << flux.M_snow << std::endl;
+        snow_cells.push_back(c);
+        snow_surfs.push_back(surf);
+        snow_mets.push_back(met);
+        snow_props.push_back(snow);
+        snow_batch.push_back(surf, met, snow, snow_temp_guess_[c]);
+      }
+    }
 
-        // diagnostics
-        if (diagnostics_) {
-          (*evap_rate)[0][c] -= area_fracs[2][c] * mb.Me;
-          (*qE_sh)[0][c] += area_fracs[2][c] * eb.fQh;
-          (*qE_lh)[0][c] += area_fracs[2][c] * eb.fQe;
-          (*qE_lw_out)[0][c] += area_fracs[2][c] * eb.fQlwOut;
-          (*qE_cond)[0][c] += area_fracs[2][c] * eb.fQc;
-
-          (*qE_sm)[0][c] = area_fracs[2][c] * eb.fQm;
-          (*melt_rate)[0][c] = area_fracs[2][c] * mb.Mm;
-          (*snow_temp)[0][c] = snow.temp;
-          (*albedo)[0][c] += area_fracs[2][c] * surf.albedo;
-        }
+    // solve for snow temperature on this land cover's snow patches
+    if (snow_batch.size() == 0) continue;
+    n_snow_evals += snow_batch.Solve();
+    n_snow_patches += snow_batch.size();
+    max_snow_its = std::max(max_snow_its,
+            *std::max_element(snow_batch.iterations.begin(), snow_batch.iterations.end()));
+
+    for (int k=0; k!=snow_batch.size(); ++k) {
+      AmanziMesh::Entity_ID c = snow_cells[k];
+      const Relations::GroundProperties& surf = snow_surfs[k];
+      const Relations::MetData& met = snow_mets[k];
+      Relations::SnowProperties& snow = snow_props[k];
+      snow.temp = snow_batch.temp[k];
+      snow_temp_guess_[c] = snow.temp;
+
+      const Relations::EnergyBalance eb = Relations::UpdateEnergyBalanceWithSnowTemperature(surf, met, params, snow);
+      const Relations::MassBalance mb = Relations::UpdateMassBalanceWithSnow(surf, params, eb);
+      Relations::FluxBalance flux = Relations::UpdateFluxesWithSnow(surf, met, params, snow, eb, mb);
+
+      // fQe, Me positive is condensation, water flux positive to surface.  Subsurf is 0 because of snow
+      water_source[0][c] += area_fracs[2][c] * flux.M_surf;
+      energy_source[0][c] += area_fracs[2][c] * flux.E_surf * 1.e-6; // convert to MW/m^2 from W/m^2
+      snow_source[0][c] += area_fracs[2][c] * flux.M_snow;
+      new_snow[0][c] += (met.Ps + std::max(mb.Me, 0.)) * area_fracs[2][c];
+
+      const Relations::EnergyBalance deb = snow_batch.DerivativeGroundTemperature(k);
+      const Relations::MassBalance dmb = Relations::UpdateMassBalanceWithSnow(surf, params, deb);
+      Relations::FluxBalance dflux = Relations::UpdateFluxesWithSnowDerivative(deb, dmb);
+      AddPatchDerivatives(dsources_dT_, c, area_fracs[2][c], dflux, 0., 0.,
+                          mb.Me > 0. ? dmb.Me : 0.);
+
+      if (vo_->os_OK(Teuchos::VERB_EXTREME))
+        *vo_->os() << "CELL " << c << " SNOW"
+                   << ": Ms = " << flux.M_surf << ", Es = " << flux.E_surf * 1.e-6
+                   << ", Mss = " << 0. << ", Ess = " << 0.
+                   << ", Sn = " << flux.M_snow << std::endl;
+
+      // diagnostics
+      if (diagnostics_) {
+        (*evap_rate)[0][c] -= area_fracs[2][c] * mb.Me;
+        (*qE_sh)[0][c] += area_fracs[2][c] * eb.fQh;
+        (*qE_lh)[0][c] += area_fracs[2][c] * eb.fQe;
+        (*qE_lw_out)[0][c] += area_fracs[2][c] * eb.fQlwOut;
+        (*qE_cond)[0][c] += area_fracs[2][c] * eb.fQc;
+
+        (*qE_sm)[0][c] = area_fracs[2][c] * eb.fQm;
+        (*melt_rate)[0][c] = area_fracs[2][c] * mb.Mm;
+        (*snow_temp)[0][c] = snow.temp;
+        (*albedo)[0][c] += area_fracs[2][c] * surf.albedo;
       }
     }
   }
 
+  if (vo_->os_OK(Teuchos::VERB_HIGH))
+    *vo_->os() << "SEB: solved snow temperature on " << n_snow_patches << " patches, "
+               << n_snow_evals << " total / " << max_snow_its << " max iterations" << std::endl;
+
   // debugging
   if (diagnostics_ && vo_->os_OK(Teuchos::VERB_HIGH)) {
     *vo_->os() << "----------------------------------------------------------------" << std::endl
@@ -574,8 +660,28 @@ SEBThreeComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
 void
 SEBThreeComponentEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
-        Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> > & results) {
-  AMANZI_ASSERT(false);
+        Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> > & results)
+{
+  // the partial derivatives are calculated by EvaluateField_()
+  HasFieldChanged(S, Keys::getDerivKey(my_keys_[0], wrt_key));
+  for (const auto& result : results) result->PutScalar(0.);
+  if (wrt_key == surf_temp_key_) AccumulateDerivative_(dsources_dT_, nullptr, results);
+}
+
+
+void
+SEBThreeComponentEvaluator::AccumulateDerivative_(const std::vector<std::vector<double> >& dsources,
+        const Epetra_MultiVector* ddep, const std::vector<Teuchos::Ptr<CompositeVector> >& results)
+{
+  for (int i=0; i!=6; ++i) {
+    auto& result = *results[i]->ViewComponent("cell",false);
+    int ncells = dsources[i].size();
+    for (int c=0; c!=ncells; ++c) {
+      // subsurface sources live on the top cell of the column
+      int cc = (i == 2 || i == 3) ? top_cells_[c] : c;
+      result[0][cc] += dsources[i][c] * (ddep ? (*ddep)[0][c] : 1.);
+    }
+  }
 }
 
 void
@@ -694,16 +800,68 @@ SEBThreeComponentEvaluator::EnsureCompatibility(const Teuchos::Ptr<State>& S)
     // additionally MANUALLY require the area frac, because it is not in the
     // list of dependencies :ISSUE:#8
     //S->RequireField(area_frac_key_)->Update(domain_fac_3);
+
+    // derivatives of the sources are calculated along with them, so size
+    // their storage now so that they are never read out of bounds, and find
+    // the subsurface cell at the top of each column
+    const auto& mesh = *S->GetMesh(domain_);
+    const auto& mesh_ss = *S->GetMesh(domain_ss_);
+    int ncells = mesh.num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+    dsources_dT_.assign(6, std::vector<double>(ncells, 0.));
+    top_cells_.resize(ncells);
+    for (int c=0; c!=ncells; ++c) {
+      AmanziMesh::Entity_ID_List cells;
+      mesh_ss.face_get_cells(mesh.entity_get_parent(AmanziMesh::CELL, c),
+                             AmanziMesh::Parallel_type::OWNED, &cells);
+      AMANZI_ASSERT(cells.size() == 1);
+      top_cells_[c] = cells[0];
+    }
     compatible_ = true;
   }
 }
 
 
+// ---------------------------------------------------------------------------
+// Updates the total derivative d(source)/d(wrt_field) of the sources in state
+// S.
+//
+// Derived to use the partial derivatives with respect to surface temperature
+// calculated along with the sources, and to map derivatives of the subsurface
+// sources onto the subsurface mesh.  The diagnostics are not differentiated.
+// ---------------------------------------------------------------------------
 void
 SEBThreeComponentEvaluator::UpdateFieldDerivative_(const Teuchos::Ptr<State>& S, Key wrt_key)
 {
-  Errors::Message message("SEBTwoComponentEvaluator: cannot differentiate with respect to anything.");
-  Exceptions::amanzi_throw(message);
+  std::vector<Teuchos::Ptr<CompositeVector> > dmys;
+  for (int i=0; i!=6; ++i) {
+    Key dmy_key = Keys::getDerivKey(my_keys_[i], wrt_key);
+    Teuchos::RCP<CompositeVector> dmy;
+    if (S->HasField(dmy_key)) {
+      dmy = S->GetFieldData(dmy_key, my_keys_[0]);
+    } else {
+      Teuchos::RCP<CompositeVectorSpace> my_fac = S->RequireField(my_keys_[i]);
+      S->RequireField(dmy_key, my_keys_[0])->Update(*my_fac);
+      dmy = Teuchos::rcp(new CompositeVector(*my_fac));
+      S->SetData(dmy_key, my_keys_[0], dmy);
+      S->GetField(dmy_key, my_keys_[0])->set_initialized();
+      S->GetField(dmy_key, my_keys_[0])->set_io_vis(false);
+      S->GetField(dmy_key, my_keys_[0])->set_io_checkpoint(false);
+    }
+    dmy->PutScalar(0.);
+    dmys.push_back(dmy.ptr());
+  }
+
+  // the partial derivatives are calculated by EvaluateField_(), so make sure
+  // it is current with the dependencies
+  HasFieldChanged(S, Keys::getDerivKey(my_keys_[0], wrt_key));
+
+  if (wrt_key == surf_temp_key_) {
+    AccumulateDerivative_(dsources_dT_, nullptr, dmys);
+  } else if (S->GetFieldEvaluator(surf_temp_key_)->IsDependency(S, wrt_key)) {
+    Key ddep_key = Keys::getDerivKey(surf_temp_key_, wrt_key);
+    AccumulateDerivative_(dsources_dT_,
+                          S->GetFieldData(ddep_key)->ViewComponent("cell",false).get(), dmys);
+  }
 }
 
 } // namespace Relations
@@ -25,6 +25,26 @@ depth/geometry-based approach for water.  All snow is assumed to first cover
 water (likely ice), then cover land, as both water and snow prefer low-lying
 depressions due to gravity- and wind-driven redistributions, respectively.
 
+Derivatives of the sources with respect to surface temperature are calculated
+analytically along with the sources, so that they may be used in
+preconditioners.  Only the direct dependence on the surface temperature is
+differentiated; derivatives with respect to other primary variables are
+formed by the chain rule through the surface temperature alone.  In
+particular, the following are held fixed, even though they typically depend
+upon temperature or pressure:
+
+- the unfrozen fraction and the liquid mass and molar densities,
+- the area fractions, albedos and emissivities,
+- the surface pressure, which enters the water and snow patches directly,
+  and the subsurface pressure, gas saturation and porosity, which enter the
+  bare ground patch.
+
+Unlike the two-component model, there is no ponded depth derivative.  Here
+the bare ground patch sees no ponded water by definition, and the water patch
+sees at least the water transition depth, so on both patches all evaporation
+is taken from a single system and the patch fluxes do not depend upon ponded
+depth.  Ponded depth affects the sources only through the area fractions.
+
 .. _seb_subgrid_evaluator-spec:
 .. admonition:: seb_subgrid_evaluator-spec
 
@@ -133,10 +153,15 @@ class SEBThreeComponentEvaluator : public SecondaryVariablesFieldEvaluator {
           Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> > & results);
 
   // this is non-standard practice.  Implementing UpdateFieldDerivative_ to
-  // override the default chain rule behavior, instead doing a numerical
-  // finite difference
+  // override the default chain rule behavior, instead using the derivatives
+  // calculated in EvaluateField_.
   virtual void UpdateFieldDerivative_(const Teuchos::Ptr<State>& S, Key wrt_key);
 
+  // adds dsources, optionally times ddep, into results
+  void AccumulateDerivative_(const std::vector<std::vector<double> >& dsources,
+          const Epetra_MultiVector* ddep,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
  protected:
   Key water_source_key_, energy_source_key_;
   Key ss_water_source_key_, ss_energy_source_key_;
@@ -165,6 +190,14 @@ class SEBThreeComponentEvaluator : public SecondaryVariablesFieldEvaluator {
 
   LandCoverMap land_cover_;
 
+  // snow temperature of the last evaluation, the initial guess for the next
+  std::vector<double> snow_temp_guess_;
+
+  // derivatives of the sources with respect to surface temperature, indexed
+  // by source and surface cell, and the subsurface cell below each
+  std::vector<std::vector<double> > dsources_dT_;
+  std::vector<AmanziMesh::Entity_ID> top_cells_;
+
   bool compatible_;
   bool diagnostics_;
   Teuchos::RCP<Debugger> db_;
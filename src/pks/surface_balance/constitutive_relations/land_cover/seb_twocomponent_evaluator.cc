@@ -26,6 +26,8 @@ respectively.
 
 */
 
+#include <algorithm>
+
 #include "seb_twocomponent_evaluator.hh"
 #include "seb_physics_defs.hh"
 #include "seb_physics_funcs.hh"
@@ -34,6 +36,25 @@ namespace Amanzi {
 namespace SurfaceBalance {
 namespace Relations {
 
+namespace {
+
+// Adds one patch's area-weighted flux derivatives to those of the sources,
+// in the order of the first six of my_keys_.
+void
+AddPatchDerivatives(std::vector<std::vector<double> >& dsources, AmanziMesh::Entity_ID c,
+                    double area_frac, const Relations::FluxBalance& dflux,
+                    double ss_water_factor, double ss_energy_factor, double dnew_snow)
+{
+  dsources[0][c] += area_frac * dflux.M_surf;
+  dsources[1][c] += area_frac * dflux.E_surf * 1.e-6;
+  dsources[2][c] += area_frac * dflux.M_subsurf * ss_water_factor;
+  dsources[3][c] += area_frac * dflux.E_subsurf * ss_energy_factor * 1.e-6;
+  dsources[4][c] += area_frac * dflux.M_snow;
+  dsources[5][c] += area_frac * dnew_snow;
+}
+
+} // namespace
+
 SEBTwoComponentEvaluator::SEBTwoComponentEvaluator(Teuchos::ParameterList& plist) :
     SecondaryVariablesFieldEvaluator(plist),
     plist_(plist),
@@ -243,11 +264,35 @@ SEBTwoComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
     qE_cond->PutScalar(0.);
   }
 
+  // snow temperature is solved for all snow patches of a land cover together,
+  // warm-started from the previous evaluation
+  if (snow_temp_guess_.size() != (std::size_t) water_source.MyLength())
+    snow_temp_guess_.assign(water_source.MyLength(), NaN);
+  Relations::SnowTemperatureBatch snow_batch(params);
+  std::vector<AmanziMesh::Entity_ID> snow_cells;
+  std::vector<Relations::GroundProperties> snow_surfs;
+  std::vector<Relations::MetData> snow_mets;
+  std::vector<Relations::SnowProperties> snow_props;
+  int n_snow_patches = 0, n_snow_evals = 0, max_snow_its = 0;
+
+  // derivatives with respect to surface temperature and ponded depth,
+  // computed with the sources
+  for (auto& dsource : dsources_dT_) std::fill(dsource.begin(), dsource.end(), 0.);
+  for (auto& dsource : dsources_dh_) std::fill(dsource.begin(), dsource.end(), 0.);
+  Relations::GroundPropertiesDerivative dsurf_dT;
+  dsurf_dT.temp = 1.;
+
   for (const auto& lc : land_cover_) {
     AmanziMesh::Entity_ID_List lc_ids;
     mesh.get_set_entities(lc.first, AmanziMesh::Entity_kind::CELL,
                            AmanziMesh::Parallel_type::OWNED, &lc_ids);
 
+    snow_batch.clear();
+    snow_cells.clear();
+    snow_surfs.clear();
+    snow_mets.clear();
+    snow_props.clear();
+
     for (auto c : lc_ids) {
       // get the top cell
       AmanziMesh::Entity_ID subsurf_f = mesh.entity_get_parent(AmanziMesh::CELL, c);
@@ -268,6 +313,7 @@ SEBTwoComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
       // non-snow covered column
       if (area_fracs[0][c] > 0) {
         Relations::GroundProperties surf;
+        Relations::GroundPropertiesDerivative dsurf_dh;
         surf.temp = surf_temp[0][c];
         surf.water_transition_depth = lc.second.water_transition_depth;
         if (ponded_depth[0][c] > lc.second.water_transition_depth) {
@@ -280,9 +326,18 @@ SEBTwoComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
           surf.pressure = factor*surf_pres[0][c] + (1-factor)*ss_pres[0][cells[0]];
           surf.porosity = factor + (1-factor)*poro[0][cells[0]];
           surf.saturation_gas = (1-factor)*sat_gas[0][cells[0]];
+
+          double dfactor = ponded_depth[0][c] > 0. ? 1. / lc.second.water_transition_depth : 0.;
+          dsurf_dh.pressure = dfactor * (surf_pres[0][c] - ss_pres[0][cells[0]]);
+          dsurf_dh.porosity = dfactor * (1 - poro[0][cells[0]]);
+          dsurf_dh.saturation_gas = -dfactor * sat_gas[0][cells[0]];
+        }
+        if (model_1p1_) {
+          surf.pressure = surf_pres[0][c];
+          dsurf_dh.pressure = 0.;
         }
-        if (model_1p1_) surf.pressure = surf_pres[0][c];
         surf.ponded_depth = ponded_depth[0][c];
+        dsurf_dh.ponded_depth = 1.;
         surf.unfrozen_fraction = unfrozen_fraction[0][c];
         surf.roughness = lc.second.roughness_ground;
         if (model_1p1_) surf.density_w = 1000.;
@@ -321,6 +376,23 @@ SEBTwoComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         snow_source[0][c] += area_fracs[0][c] * flux.M_snow;
         new_snow[0][c] += area_fracs[0][c] * met.Ps;
 
+        double ss_water_factor = model_1p1_ ? area_to_volume * surf.density_w / 0.0180153
+            : area_to_volume * mol_dens[0][c];
+        {
+          const Relations::EnergyBalance deb = Relations::UpdateEnergyBalanceWithoutSnowDerivative(surf, met, params, dsurf_dT);
+          const Relations::MassBalance dmb = Relations::UpdateMassBalanceWithoutSnow(surf, params, deb);
+          Relations::FluxBalance dflux = Relations::UpdateFluxesWithoutSnowDerivative(surf, met, params, mb, dsurf_dT, deb, dmb, model_1p1_);
+          AddPatchDerivatives(dsources_dT_, c, area_fracs[0][c], dflux,
+                              ss_water_factor, area_to_volume, 0.);
+        }
+        {
+          const Relations::EnergyBalance deb = Relations::UpdateEnergyBalanceWithoutSnowDerivative(surf, met, params, dsurf_dh);
+          const Relations::MassBalance dmb = Relations::UpdateMassBalanceWithoutSnow(surf, params, deb);
+          Relations::FluxBalance dflux = Relations::UpdateFluxesWithoutSnowDerivative(surf, met, params, mb, dsurf_dh, deb, dmb, model_1p1_);
+          AddPatchDerivatives(dsources_dh_, c, area_fracs[0][c], dflux,
+                              ss_water_factor, area_to_volume, 0.);
+        }
+
         if (vo_->os_OK(Teuchos::VERB_EXTREME))
           *vo_->os() << "CELL " << c << " NO_SNOW"
                      << ": Ms = " << flux.M_surf << ", Es = " << flux.E_surf * 1.e-6
@@ -375,40 +447,72 @@ SEBTwoComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         snow.emissivity = surf.emissivity;
         snow.roughness = lc.second.roughness_snow;
 
-        const Relations::EnergyBalance eb = Relations::UpdateEnergyBalanceWithSnow(surf, met, params, snow);
-        const Relations::MassBalance mb = Relations::UpdateMassBalanceWithSnow(surf, params, eb);
-        Relations::FluxBalance flux = Relations::UpdateFluxesWithSnow(surf, met, params, snow, eb, mb);
-
-        // fQe, Me positive is condensation, water flux positive to surface.  No
-        // need for subsurf as there is snow present.
-        water_source[0][c] += area_fracs[1][c] * flux.M_surf;
-        energy_source[0][c] += area_fracs[1][c] * flux.E_surf * 1.e-6; // convert to MW/m^2 from W/m^2
-        snow_source[0][c] += area_fracs[1][c] * flux.M_snow;
-        new_snow[0][c] += std::max(met.Ps + mb.Me, 0.) * area_fracs[1][c];
-
-        if (vo_->os_OK(Teuchos::VERB_EXTREME))
-          *vo_->os() << "CELL " << c << " SNOW"
-                     << ": Ms = " << flux.M_surf << ", Es = " << flux.E_surf * 1.e-6
-                     << ", Mss = " << 0. << ", Ess = " << 0.
-                     << ", Sn = " << flux.M_snow << std::endl;
+        snow_cells.push_back(c);
+        snow_surfs.push_back(surf);
+        snow_mets.push_back(met);
+        snow_props.push_back(snow);
+        snow_batch.push_back(surf, met, snow, snow_temp_guess_[c]);
+      }
+    }
 
-        // diagnostics
-        if (diagnostics_) {
-          (*evap_rate)[0][c] -= area_fracs[1][c] * mb.Me;
-          (*qE_sh)[0][c] += area_fracs[1][c] * eb.fQh;
-          (*qE_lh)[0][c] += area_fracs[1][c] * eb.fQe;
-          (*qE_lw_out)[0][c] += area_fracs[1][c] * eb.fQlwOut;
-          (*qE_cond)[0][c] += area_fracs[1][c] * eb.fQc;
-
-          (*qE_sm)[0][c] = area_fracs[1][c] * eb.fQm;
-          (*melt_rate)[0][c] = area_fracs[1][c] * mb.Mm;
-          (*snow_temp)[0][c] = snow.temp;
-          (*albedo)[0][c] += area_fracs[1][c] * surf.albedo;
-        }
+    // solve for snow temperature on this land cover's snow patches
+    if (snow_batch.size() == 0) continue;
+    n_snow_evals += snow_batch.Solve();
+    n_snow_patches += snow_batch.size();
+    max_snow_its = std::max(max_snow_its,
+            *std::max_element(snow_batch.iterations.begin(), snow_batch.iterations.end()));
+
+    for (int k=0; k!=snow_batch.size(); ++k) {
+      AmanziMesh::Entity_ID c = snow_cells[k];
+      const Relations::GroundProperties& surf = snow_surfs[k];
+      const Relations::MetData& met = snow_mets[k];
+      Relations::SnowProperties& snow = snow_props[k];
+      snow.temp = snow_batch.temp[k];
+      snow_temp_guess_[c] = snow.temp;
+
+      const Relations::EnergyBalance eb = Relations::UpdateEnergyBalanceWithSnowTemperature(surf, met, params, snow);
+      const Relations::MassBalance mb = Relations::UpdateMassBalanceWithSnow(surf, params, eb);
+      Relations::FluxBalance flux = Relations::UpdateFluxesWithSnow(surf, met, params, snow, eb, mb);
+
+      // fQe, Me positive is condensation, water flux positive to surface.  No
+      // need for subsurf as there is snow present.
+      water_source[0][c] += area_fracs[1][c] * flux.M_surf;
+      energy_source[0][c] += area_fracs[1][c] * flux.E_surf * 1.e-6; // convert to MW/m^2 from W/m^2
+      snow_source[0][c] += area_fracs[1][c] * flux.M_snow;
+      new_snow[0][c] += std::max(met.Ps + mb.Me, 0.) * area_fracs[1][c];
+
+      const Relations::EnergyBalance deb = snow_batch.DerivativeGroundTemperature(k);
+      const Relations::MassBalance dmb = Relations::UpdateMassBalanceWithSnow(surf, params, deb);
+      Relations::FluxBalance dflux = Relations::UpdateFluxesWithSnowDerivative(deb, dmb);
+      AddPatchDerivatives(dsources_dT_, c, area_fracs[1][c], dflux, 0., 0.,
+                          met.Ps + mb.Me > 0. ? dmb.Me : 0.);
+
+      if (vo_->os_OK(Teuchos::VERB_EXTREME))
+        *vo_->os() << "CELL " << c << " SNOW"
+                   << ": Ms = " << flux.M_surf << ", Es = " << flux.E_surf * 1.e-6
+                   << ", Mss = " << 0. << ", Ess = " << 0.
+                   << ", Sn = " << flux.M_snow << std::endl;
+
+      // diagnostics
+      if (diagnostics_) {
+        (*evap_rate)[0][c] -= area_fracs[1][c] * mb.Me;
+        (*qE_sh)[0][c] += area_fracs[1][c] * eb.fQh;
+        (*qE_lh)[0][c] += area_fracs[1][c] * eb.fQe;
+        (*qE_lw_out)[0][c] += area_fracs[1][c] * eb.fQlwOut;
+        (*qE_cond)[0][c] += area_fracs[1][c] * eb.fQc;
+
+        (*qE_sm)[0][c] = area_fracs[1][c] * eb.fQm;
+        (*melt_rate)[0][c] = area_fracs[1][c] * mb.Mm;
+        (*snow_temp)[0][c] = snow.temp;
+        (*albedo)[0][c] += area_fracs[1][c] * surf.albedo;
       }
     }
   }
 
+  if (vo_->os_OK(Teuchos::VERB_HIGH))
+    *vo_->os() << "SEB: solved snow temperature on " << n_snow_patches << " patches, "
+               << n_snow_evals << " total / " << max_snow_its << " max iterations" << std::endl;
+
   // debugging
   if (diagnostics_ && vo_->os_OK(Teuchos::VERB_HIGH)) {
     *vo_->os() << "----------------------------------------------------------------" << std::endl
@@ -518,7 +622,30 @@ SEBTwoComponentEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
 void
 SEBTwoComponentEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
-        Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> > & results) {}
+        Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> > & results)
+{
+  // the partial derivatives are calculated by EvaluateField_()
+  HasFieldChanged(S, Keys::getDerivKey(my_keys_[0], wrt_key));
+  for (const auto& result : results) result->PutScalar(0.);
+  if (wrt_key == surf_temp_key_) AccumulateDerivative_(dsources_dT_, nullptr, results);
+  if (wrt_key == ponded_depth_key_) AccumulateDerivative_(dsources_dh_, nullptr, results);
+}
+
+
+void
+SEBTwoComponentEvaluator::AccumulateDerivative_(const std::vector<std::vector<double> >& dsources,
+        const Epetra_MultiVector* ddep, const std::vector<Teuchos::Ptr<CompositeVector> >& results)
+{
+  for (int i=0; i!=6; ++i) {
+    auto& result = *results[i]->ViewComponent("cell",false);
+    int ncells = dsources[i].size();
+    for (int c=0; c!=ncells; ++c) {
+      // subsurface sources live on the top cell of the column
+      int cc = (i == 2 || i == 3) ? top_cells_[c] : c;
+      result[0][cc] += dsources[i][c] * (ddep ? (*ddep)[0][c] : 1.);
+    }
+  }
+}
 
 
 void
@@ -634,16 +761,74 @@ SEBTwoComponentEvaluator::EnsureCompatibility(const Teuchos::Ptr<State>& S)
     // list of dependencies :ISSUE:#8
     //S->RequireField(area_frac_key_)->Update(domain_fac_2);
 
+    // derivatives of the sources are calculated along with them, so size
+    // their storage now so that they are never read out of bounds, and find
+    // the subsurface cell at the top of each column
+    const auto& mesh = *S->GetMesh(domain_);
+    const auto& mesh_ss = *S->GetMesh(domain_ss_);
+    int ncells = mesh.num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+    dsources_dT_.assign(6, std::vector<double>(ncells, 0.));
+    dsources_dh_.assign(6, std::vector<double>(ncells, 0.));
+    top_cells_.resize(ncells);
+    for (int c=0; c!=ncells; ++c) {
+      AmanziMesh::Entity_ID_List cells;
+      mesh_ss.face_get_cells(mesh.entity_get_parent(AmanziMesh::CELL, c),
+                             AmanziMesh::Parallel_type::OWNED, &cells);
+      AMANZI_ASSERT(cells.size() == 1);
+      top_cells_[c] = cells[0];
+    }
+
     compatible_ = true;
   }
 }
 
 
+// ---------------------------------------------------------------------------
+// Updates the total derivative d(source)/d(wrt_field) of the sources in state
+// S.
+//
+// Derived to use the partial derivatives with respect to surface temperature
+// and ponded depth calculated along with the sources, and to map derivatives
+// of the subsurface sources onto the subsurface mesh.  The diagnostics are
+// not differentiated.
+// ---------------------------------------------------------------------------
 void
 SEBTwoComponentEvaluator::UpdateFieldDerivative_(const Teuchos::Ptr<State>& S, Key wrt_key)
 {
-  Errors::Message message("SEBTwoComponentEvaluator: cannot differentiate with respect to anything.");
-  Exceptions::amanzi_throw(message);
+  std::vector<Teuchos::Ptr<CompositeVector> > dmys;
+  for (int i=0; i!=6; ++i) {
+    Key dmy_key = Keys::getDerivKey(my_keys_[i], wrt_key);
+    Teuchos::RCP<CompositeVector> dmy;
+    if (S->HasField(dmy_key)) {
+      dmy = S->GetFieldData(dmy_key, my_keys_[0]);
+    } else {
+      Teuchos::RCP<CompositeVectorSpace> my_fac = S->RequireField(my_keys_[i]);
+      S->RequireField(dmy_key, my_keys_[0])->Update(*my_fac);
+      dmy = Teuchos::rcp(new CompositeVector(*my_fac));
+      S->SetData(dmy_key, my_keys_[0], dmy);
+      S->GetField(dmy_key, my_keys_[0])->set_initialized();
+      S->GetField(dmy_key, my_keys_[0])->set_io_vis(false);
+      S->GetField(dmy_key, my_keys_[0])->set_io_checkpoint(false);
+    }
+    dmy->PutScalar(0.);
+    dmys.push_back(dmy.ptr());
+  }
+
+  // the partial derivatives are calculated by EvaluateField_(), so make sure
+  // it is current with the dependencies
+  HasFieldChanged(S, Keys::getDerivKey(my_keys_[0], wrt_key));
+
+  std::vector<std::pair<Key, const std::vector<std::vector<double> >*> > deps = {
+    {surf_temp_key_, &dsources_dT_}, {ponded_depth_key_, &dsources_dh_} };
+  for (const auto& dep : deps) {
+    if (wrt_key == dep.first) {
+      AccumulateDerivative_(*dep.second, nullptr, dmys);
+    } else if (S->GetFieldEvaluator(dep.first)->IsDependency(S, wrt_key)) {
+      Key ddep_key = Keys::getDerivKey(dep.first, wrt_key);
+      AccumulateDerivative_(*dep.second,
+                            S->GetFieldData(ddep_key)->ViewComponent("cell",false).get(), dmys);
+    }
+  }
 }
 
 }  // namespace Relations
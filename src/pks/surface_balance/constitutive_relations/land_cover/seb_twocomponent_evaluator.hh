@@ -15,6 +15,12 @@ temperature, given a skin temperature, that satisfies a energy balance
 equation.  In the case of no-snow, this calculates a conductive heat flux to
 the ground from the atmosphere.
 
+Derivatives of the sources with respect to surface temperature and ponded
+depth are calculated analytically along with the sources, so that they may be
+used in preconditioners.  All other dependencies, including the area
+fractions, the unfrozen fraction, the liquid densities and the surface
+pressure, are not differentiated, even though they typically depend upon
+temperature or pressure.
 
 .. _seb_evaluator-spec:
 .. admonition:: seb_evaluator-spec
@@ -130,10 +136,15 @@ class SEBTwoComponentEvaluator : public SecondaryVariablesFieldEvaluator {
           Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> > & results);
 
   // this is non-standard practice.  Implementing UpdateFieldDerivative_ to
-  // override the default chain rule behavior, instead doing a numerical
-  // finite difference
+  // override the default chain rule behavior, instead using the derivatives
+  // calculated in EvaluateField_.
   virtual void UpdateFieldDerivative_(const Teuchos::Ptr<State>& S, Key wrt_key);
 
+  // adds dsources, optionally times ddep, into results
+  void AccumulateDerivative_(const std::vector<std::vector<double> >& dsources,
+          const Epetra_MultiVector* ddep,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
  protected:
   Key water_source_key_, energy_source_key_;
   Key ss_water_source_key_, ss_energy_source_key_;
@@ -162,6 +173,16 @@ class SEBTwoComponentEvaluator : public SecondaryVariablesFieldEvaluator {
 
   LandCoverMap land_cover_;
 
+  // snow temperature of the last evaluation, the initial guess for the next
+  std::vector<double> snow_temp_guess_;
+
+  // derivatives of the sources with respect to surface temperature and
+  // ponded depth, indexed by source and surface cell, and the subsurface cell
+  // below each
+  std::vector<std::vector<double> > dsources_dT_;
+  std::vector<std::vector<double> > dsources_dh_;
+  std::vector<AmanziMesh::Entity_ID> top_cells_;
+
   bool diagnostics_;
   Teuchos::RCP<Debugger> db_;
   Teuchos::RCP<Debugger> db_ss_;
@@ -0,0 +1,181 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+*/
+
+// Checks the analytic derivatives of the SEB fluxes with respect to ground
+// temperature, as used by the SEB evaluators, against finite differences.
+
+#include <cmath>
+#include <functional>
+#include "UnitTest++.h"
+
+#include "seb_physics_defs.hh"
+#include "seb_physics_funcs.hh"
+
+using namespace Amanzi::SurfaceBalance::Relations;
+
+namespace {
+
+MetData
+Met(double air_temp)
+{
+  MetData met;
+  met.Z_Us = 2.;
+  met.Us = 3.;
+  met.QswIn = 250.;
+  met.QlwIn = 280.;
+  met.air_temp = air_temp;
+  met.relative_humidity = 0.6;
+  met.Pr = 1.e-8;
+  met.Ps = 0.;
+  return met;
+}
+
+GroundProperties
+Ground(double temp, double ponded_depth)
+{
+  GroundProperties surf;
+  surf.temp = temp;
+  surf.pressure = 101325. - 2000.;
+  surf.roughness = 0.04;
+  surf.density_w = 1000.;
+  surf.dz = 0.1;
+  surf.albedo = 0.2;
+  surf.emissivity = 0.95;
+  surf.ponded_depth = ponded_depth;
+  surf.porosity = ponded_depth > 0. ? 1. : 0.4;
+  surf.saturation_gas = ponded_depth > 0. ? 0. : 0.3;
+  surf.unfrozen_fraction = 1.;
+  surf.water_transition_depth = 0.02;
+  return surf;
+}
+
+FluxBalance
+FluxesWithoutSnow(const GroundProperties& surf, const MetData& met)
+{
+  ModelParams params;
+  EnergyBalance eb = UpdateEnergyBalanceWithoutSnow(surf, met, params);
+  MassBalance mb = UpdateMassBalanceWithoutSnow(surf, params, eb);
+  return UpdateFluxesWithoutSnow(surf, met, params, eb, mb);
+}
+
+// fluxes of one snow patch, and the new snow as added by the evaluators
+FluxBalance
+FluxesWithSnow(const GroundProperties& surf, const MetData& met,
+               const SnowProperties& snow_in, double& new_snow)
+{
+  ModelParams params;
+  SnowTemperatureBatch batch(params);
+  batch.push_back(surf, met, snow_in, NaN);
+  batch.Solve();
+
+  SnowProperties snow(snow_in);
+  snow.temp = batch.temp[0];
+  EnergyBalance eb = UpdateEnergyBalanceWithSnowTemperature(surf, met, params, snow);
+  MassBalance mb = UpdateMassBalanceWithSnow(surf, params, eb);
+  new_snow = met.Ps + std::max(mb.Me, 0.);
+  return UpdateFluxesWithSnow(surf, met, params, snow, eb, mb);
+}
+
+void
+CheckFluxDerivative(const FluxBalance& dflux,
+                    const std::function<FluxBalance(double)>& flux, double T, double eps)
+{
+  FluxBalance fp = flux(T + eps);
+  FluxBalance fm = flux(T - eps);
+
+  auto check = [](double fd, double d) {
+    CHECK_CLOSE(fd, d, 1.e-5 * std::abs(fd) + 1.e-14);
+  };
+  check((fp.M_surf - fm.M_surf) / (2*eps), dflux.M_surf);
+  check((fp.E_surf - fm.E_surf) / (2*eps), dflux.E_surf);
+  check((fp.M_subsurf - fm.M_subsurf) / (2*eps), dflux.M_subsurf);
+  check((fp.E_subsurf - fm.E_subsurf) / (2*eps), dflux.E_subsurf);
+  check((fp.M_snow - fm.M_snow) / (2*eps), dflux.M_snow);
+}
+
+void
+CheckWithoutSnow(double T, double air_temp, double ponded_depth)
+{
+  ModelParams params;
+  MetData met = Met(air_temp);
+  GroundProperties surf = Ground(T, ponded_depth);
+  GroundPropertiesDerivative dsurf_dT;
+  dsurf_dT.temp = 1.;
+
+  EnergyBalance eb = UpdateEnergyBalanceWithoutSnow(surf, met, params);
+  MassBalance mb = UpdateMassBalanceWithoutSnow(surf, params, eb);
+  EnergyBalance deb = UpdateEnergyBalanceWithoutSnowDerivative(surf, met, params, dsurf_dT);
+  MassBalance dmb = UpdateMassBalanceWithoutSnow(surf, params, deb);
+  FluxBalance dflux = UpdateFluxesWithoutSnowDerivative(surf, met, params, mb, dsurf_dT, deb, dmb);
+
+  CheckFluxDerivative(dflux, [&](double T_) {
+      return FluxesWithoutSnow(Ground(T_, ponded_depth), met); }, T, 1.e-4);
+}
+
+void
+CheckWithSnow(double T, double air_temp)
+{
+  ModelParams params;
+  MetData met = Met(air_temp);
+  GroundProperties surf = Ground(T, 0.);
+
+  SnowProperties snow;
+  snow.height = 0.3;
+  snow.density = 250.;
+  snow.albedo = 0.8;
+  snow.emissivity = 0.98;
+  snow.roughness = 0.004;
+
+  SnowTemperatureBatch batch(params);
+  batch.push_back(surf, met, snow, NaN);
+  batch.Solve();
+  snow.temp = batch.temp[0];
+  EnergyBalance eb = UpdateEnergyBalanceWithSnowTemperature(surf, met, params, snow);
+  MassBalance mb = UpdateMassBalanceWithSnow(surf, params, eb);
+
+  EnergyBalance deb = batch.DerivativeGroundTemperature(0);
+  MassBalance dmb = UpdateMassBalanceWithSnow(surf, params, deb);
+  FluxBalance dflux = UpdateFluxesWithSnowDerivative(deb, dmb);
+
+  // the snow temperature is only solved to a tolerance, so the difference
+  // must be large enough to not see the solver's error
+  const double eps = 1.e-2;
+  CheckFluxDerivative(dflux, [&](double T_) {
+      double new_snow;
+      return FluxesWithSnow(Ground(T_, 0.), met, snow, new_snow); }, T, eps);
+
+  // new snow from frost
+  double new_snow_p, new_snow_m;
+  FluxesWithSnow(Ground(T + eps, 0.), met, snow, new_snow_p);
+  FluxesWithSnow(Ground(T - eps, 0.), met, snow, new_snow_m);
+  double dnew_snow = mb.Me > 0. ? dmb.Me : 0.;
+  CHECK_CLOSE((new_snow_p - new_snow_m) / (2*eps), dnew_snow,
+              1.e-5 * std::abs(dnew_snow) + 1.e-14);
+}
+
+} // namespace
+
+
+TEST(SEB_DERIVATIVE_BARE_GROUND) {
+  CheckWithoutSnow(283.15, 288.15, 0.);
+  CheckWithoutSnow(293.15, 278.15, 0.);
+}
+
+TEST(SEB_DERIVATIVE_PONDED_WATER) {
+  CheckWithoutSnow(283.15, 288.15, 0.1);
+  CheckWithoutSnow(293.15, 278.15, 0.1);
+}
+
+TEST(SEB_DERIVATIVE_PARTIALLY_PONDED) {
+  CheckWithoutSnow(283.15, 288.15, 0.01);
+}
+
+TEST(SEB_DERIVATIVE_SNOW) {
+  // cold snowpack, snow temperature below freezing
+  CheckWithSnow(268.15, 258.15);
+  // melting snowpack, snow temperature limited to freezing
+  CheckWithSnow(272.15, 283.15);
+}
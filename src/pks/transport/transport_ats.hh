@@ -106,6 +106,9 @@ The advection-diffusion equation for component *i* in the surface may be written
     * `"transport subcycling`" ``[bool]`` **true** The code will default to subcycling for transport within
       the master PK if there is one.
 
+    * `"number of threads`" ``[int]`` **1** Number of OpenMP threads used by
+      the first order advection kernel.  If <= 0, uses all available threads.
+
 
     Developer parameters:
 
@@ -246,6 +249,7 @@ The advection-diffusion equation for component *i* in the surface may be written
 #include "Epetra_IntVector.h"
 #include "Epetra_Import.h"
 #include "Teuchos_RCP.hpp"
+#include "Teuchos_TimeMonitor.hpp"
 
 // Amanzi
 #include "CompositeVector.hh"
@@ -385,6 +389,7 @@ private:
 
   // advection members
   void AdvanceDonorUpwind(double dT);
+  void AdvectDonorUpwindBlocked_(int num_advect);
   void AdvanceSecondOrderUpwindRKn(double dT);
   void AdvanceSecondOrderUpwindRK1(double dT);
   void AdvanceSecondOrderUpwindRK2(double dT);
@@ -477,6 +482,8 @@ protected:
   Teuchos::RCP<CompositeVector> tcc_w_src;
   Teuchos::RCP<CompositeVector> tcc_tmp;  // next tcc
   Teuchos::RCP<CompositeVector> tcc;  // smart mirrow of tcc
+  Teuchos::RCP<CompositeVector> tcc_subcycle_;  // second buffer for subcycling
+  Teuchos::RCP<Teuchos::Time> subcycle_timer_;
   Teuchos::RCP<Epetra_MultiVector> conserve_qty_, solid_qty_, water_qty_;
   Teuchos::RCP<const Epetra_MultiVector> flux_;
   Teuchos::RCP<const Epetra_MultiVector> ws_, ws_prev_, phi_, mol_dens_, mol_dens_prev_;
@@ -535,6 +542,13 @@ protected:
 
   int ncells_owned, ncells_wghost;
   int nfaces_owned, nfaces_wghost;
+
+  // first order advection kernel: faces of owned cells, single-cell faces of
+  // owned cells, and cell-major (all species of a cell contiguous) workspace
+  std::vector<int> cell_face_offsets_, cell_faces_;
+  std::vector<int> bnd_faces_;
+  std::vector<double> tcc_cell_major_, cons_cell_major_;
+  int n_threads_;
   int nnodes_wghost;
 
   std::vector<std::string> component_names_;  // details of components
@@ -38,6 +38,7 @@ void Transport_ATS::InitializeAll_()
   if (spatial_disc_order < 1 || spatial_disc_order > 2) spatial_disc_order = 1;
   temporal_disc_order = plist_->get<int>("temporal discretization order", 1);
   if (temporal_disc_order < 1 || temporal_disc_order > 2) temporal_disc_order = 1;
+  n_threads_ = plist_->get<int>("number of threads", 1);
 
   num_aqueous = plist_->get<int>("number of aqueous components", component_names_.size());
   num_gaseous = plist_->get<int>("number of gaseous components", 0);
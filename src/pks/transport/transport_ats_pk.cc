@@ -12,6 +12,10 @@
 #include <algorithm>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "boost/algorithm/string.hpp"
 #include "Epetra_Vector.h"
 #include "Epetra_IntVector.h"
@@ -30,6 +34,7 @@
 #include "PDE_Accumulation.hh"
 #include "PK_DomainFunctionFactory.hh"
 #include "PK_Utils.hh"
+#include "pk_helpers.hh"
 
 
 #include "MultiscaleTransportPorosityFactory.hh"
@@ -72,6 +77,7 @@ Transport_ATS::Transport_ATS(Teuchos::ParameterList& pk_tree,
 
   // are we subcycling?
   subcycling_ = plist_->get<bool>("transport subcycling", false);
+  subcycle_timer_ = Teuchos::TimeMonitor::getNewCounter("transport subcycle");
 
   // initialize io
   Teuchos::RCP<Teuchos::ParameterList> units_list = Teuchos::sublist(glist, "units");
@@ -351,6 +357,24 @@ void Transport_ATS::Initialize(const Teuchos::Ptr<State>& S)
 
   IdentifyUpwindCells();
 
+  // faces of owned cells, for the owner-computes advection kernel
+  {
+    AmanziMesh::Entity_ID_List faces, cells;
+    cell_face_offsets_.resize(ncells_owned + 1);
+    cell_face_offsets_[0] = 0;
+    cell_faces_.clear();
+    bnd_faces_.clear();
+    for (int c = 0; c < ncells_owned; c++) {
+      mesh_->cell_get_faces(c, &faces);
+      for (int f : faces) {
+        cell_faces_.push_back(f);
+        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
+        if (cells.size() == 1) bnd_faces_.push_back(f);
+      }
+      cell_face_offsets_[c+1] = cell_faces_.size();
+    }
+  }
+
   // advection block initialization
   current_component_ = -1;
 
@@ -851,8 +875,16 @@ bool Transport_ATS::AdvanceStep(double t_old, double t_new, bool reinit)
     }
   }
 
+  // The subcycle reads tcc and writes tcc_tmp.  After the first cycle, these
+  // alternate between the state's subcycling copy and a second buffer, so
+  // that no memory is allocated or copied per subcycle.
+  Teuchos::RCP<CompositeVector> tcc_copy = tcc_tmp;
+  double subcycle_time_start = subcycle_timer_->totalElapsedTime();
+
   int ncycles = 0, swap = 1;
   while (dt_sum < dt_MPC - 1e-6) {
+    auto monitor = startTimer(*subcycle_timer_);
+
     // update boundary conditions
     time = t_physics_ + dt_cycle / 2;
     for (int i = 0; i < bcs_.size(); i++) {
@@ -913,13 +945,32 @@ bool Transport_ATS::AdvanceStep(double t_old, double t_new, bool reinit)
       AddMultiscalePorosity_(t_old, t_new, t_int1, t_int2);
     }
 
-    if (! final_cycle) {  // rotate concentrations (we need new memory for tcc)
-      tcc = Teuchos::RCP<CompositeVector>(new CompositeVector(*tcc_tmp));
+    if (! final_cycle) {  // rotate concentrations
+      if (tcc_subcycle_ == Teuchos::null) {
+        tcc_subcycle_ = Teuchos::rcp(new CompositeVector(*tcc_tmp));
+      }
+      Teuchos::RCP<CompositeVector> tcc_next = tcc_tmp == tcc_copy ? tcc_subcycle_ : tcc_copy;
+      tcc = tcc_tmp;
+      tcc_tmp = tcc_next;
+
+      // not all schemes advance the gaseous components, which must carry over
+      const Epetra_MultiVector& tcc_prev_c = *tcc->ViewComponent("cell", true);
+      Epetra_MultiVector& tcc_next_c = *tcc_tmp->ViewComponent("cell", true);
+      for (int i = num_aqueous; i < tcc_next_c.NumVectors(); ++i) {
+        tcc_next_c(i)->Update(1.0, *tcc_prev_c(i), 0.0);
+      }
     }
 
     ncycles++;
   }
 
+  // the result must end up in the state's subcycling copy
+  if (tcc_tmp != tcc_copy) {
+    *tcc_copy->ViewComponent("cell", true) = *tcc_tmp->ViewComponent("cell", true);
+    tcc_tmp = tcc_copy;
+  }
+  double subcycle_time = subcycle_timer_->totalElapsedTime() - subcycle_time_start;
+
   dt_ = dt_stable;  // restore the original time step (just in case)
 
   Epetra_MultiVector& tcc_next = *tcc_tmp->ViewComponent("cell", false);
@@ -936,6 +987,10 @@ bool Transport_ATS::AdvanceStep(double t_old, double t_new, bool reinit)
   if (vo_->os_OK(Teuchos::VERB_MEDIUM)) {
     *vo_->os() << ncycles << " sub-cycles, dt_stable=" << units_.OutputTime(dt_stable)
                << " [sec]  dt_MPC=" << units_.OutputTime(dt_MPC) << " [sec]" << std::endl;
+    if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+      *vo_->os() << "  subcycle wallclock: " << subcycle_time << " [sec] total, "
+                 << subcycle_time / std::max(ncycles, 1) << " [sec] per sub-cycle" << std::endl;
+    }
 
     VV_PrintSoluteExtrema(tcc_next, dt_MPC);
   }
@@ -1282,43 +1337,7 @@ void Transport_ATS::AdvanceDonorUpwind(double dt_cycle)
   mesh_->get_comm()->SumAll(&tmp1, &mass_start, 1);
 
   // advance all components at once
-  for (int f = 0; f < nfaces_wghost; f++) {  // loop over master and slave faces
-    int c1 = (*upwind_cell_)[f];
-    int c2 = (*downwind_cell_)[f];
-    double u = fabs((*flux_)[0][f]);
-
-    if (c1 >=0 && c1 < ncells_owned && c2 >= 0 && c2 < ncells_owned) {
-      for (int i = 0; i < num_advect; i++) {
-        double tcc_flux = dt_ * u * tcc_prev[i][c1];
-        (*conserve_qty_)[i][c1] -= tcc_flux;
-        (*conserve_qty_)[i][c2] += tcc_flux;
-      }
-      (*conserve_qty_)[num_components+1][c1] -= dt_ * u;
-      (*conserve_qty_)[num_components+1][c2] += dt_ * u;
-    }
-    else if (c1 >=0 && c1 < ncells_owned && (c2 >= ncells_owned || c2 < 0)) {
-      for (int i = 0; i < num_advect; i++) {
-        double tcc_flux = dt_ * u * tcc_prev[i][c1];
-        (*conserve_qty_)[i][c1] -= tcc_flux;
-        if (c2 < 0) mass_solutes_bc_[i] -= tcc_flux;
-        //AmanziGeometry::Point normal = mesh_->face_normal(f);
-      }
-      (*conserve_qty_)[num_components+1][c1] -= dt_ * u;
-
-    } else if (c1 >= ncells_owned && c2 >= 0 && c2 < ncells_owned) {
-      for (int i = 0; i < num_advect; i++) {
-        double tcc_flux = dt_ * u * tcc_prev[i][c1];
-        (*conserve_qty_)[i][c2] += tcc_flux;
-      }
-      (*conserve_qty_)[num_components+1][c2] += dt_ * u;
-
-    } else if (c2 < 0 && c1 >= 0 && c1 < ncells_owned) {
-      (*conserve_qty_)[num_components+1][c1] -= dt_ * u;
-
-    } else if (c1 < 0 && c2 >= 0 && c2 < ncells_owned) {
-      (*conserve_qty_)[num_components+1][c2] += dt_ * u;
-    }
-  }
+  AdvectDonorUpwindBlocked_(num_advect);
 
   // loop over exterior boundary sets
   for (int m = 0; m < bcs_.size(); m++) {
@@ -1410,6 +1429,86 @@ void Transport_ATS::AdvanceDonorUpwind(double dt_cycle)
 }
 
 
+/* *******************************************************************
+ * Advective fluxes of the first order scheme, added to conserve_qty_.
+ *
+ * Concentrations are copied to cell-major storage, so that all species of
+ * a cell are contiguous, and each owned cell gathers the fluxes through its
+ * own faces.  Each thread then writes only to the cells it owns, so no
+ * coloring or atomics are needed.
+ ****************************************************************** */
+void Transport_ATS::AdvectDonorUpwindBlocked_(int num_advect)
+{
+  const Epetra_MultiVector& tcc_prev = *tcc->ViewComponent("cell", true);
+  int num_components = tcc_prev.NumVectors();
+  double* water = (*conserve_qty_)[num_components+1];
+
+  int n_threads = 1;
+#ifdef _OPENMP
+  n_threads = n_threads_ > 0 ? n_threads_ : omp_get_max_threads();
+#endif
+
+  tcc_cell_major_.resize(ncells_wghost * num_advect);
+  cons_cell_major_.resize(ncells_owned * num_advect);
+  double* tcc_cm = tcc_cell_major_.data();
+  double* cons_cm = cons_cell_major_.data();
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+  for (int c = 0; c < ncells_wghost; c++) {
+    for (int i = 0; i < num_advect; i++) tcc_cm[c * num_advect + i] = tcc_prev[i][c];
+    if (c < ncells_owned) {
+      for (int i = 0; i < num_advect; i++) cons_cm[c * num_advect + i] = (*conserve_qty_)[i][c];
+    }
+  }
+
+  const int* offsets = cell_face_offsets_.data();
+  const int* cell_faces = cell_faces_.data();
+  const Epetra_IntVector& upwind_cell = *upwind_cell_;
+  const Epetra_IntVector& downwind_cell = *downwind_cell_;
+  const Epetra_MultiVector& flux = *flux_;
+  double dt = dt_;
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+  for (int c = 0; c < ncells_owned; c++) {
+    double* cons_c = cons_cm + c * num_advect;
+    for (int k = offsets[c]; k < offsets[c+1]; k++) {
+      int f = cell_faces[k];
+      int c1 = upwind_cell[f];
+      int c2 = downwind_cell[f];
+      double dt_u = dt * fabs(flux[0][f]);
+
+      if (c1 == c) {
+        // outflow
+        const double* tcc_c = tcc_cm + c * num_advect;
+        for (int i = 0; i < num_advect; i++) cons_c[i] -= dt_u * tcc_c[i];
+        water[c] -= dt_u;
+      } else if (c2 == c) {
+        // inflow, from a cell or (handled by the boundary sets) the boundary
+        if (c1 >= 0) {
+          const double* tcc_c1 = tcc_cm + c1 * num_advect;
+          for (int i = 0; i < num_advect; i++) cons_c[i] += dt_u * tcc_c1[i];
+        }
+        water[c] += dt_u;
+      }
+    }
+  }
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+  for (int c = 0; c < ncells_owned; c++) {
+    for (int i = 0; i < num_advect; i++) (*conserve_qty_)[i][c] = cons_cm[c * num_advect + i];
+  }
+
+  // mass leaving through the boundary
+  for (int f : bnd_faces_) {
+    int c1 = upwind_cell[f];
+    if (c1 >= 0 && downwind_cell[f] < 0) {
+      double dt_u = dt * fabs(flux[0][f]);
+      for (int i = 0; i < num_advect; i++) mass_solutes_bc_[i] -= dt_u * tcc_cm[c1 * num_advect + i];
+    }
+  }
+}
+
+
 /* *******************************************************************
  * We have to advance each component independently due to different
  * reconstructions. We use tcc when only owned data are needed and